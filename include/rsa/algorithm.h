@@ -1,5 +1,7 @@
 #include "big_integer.h"
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace BNAlgo
 {
@@ -8,4 +10,11 @@ namespace BNAlgo
     BigInt inv(const BigInt &a, const BigInt &n, bool is_prime = false);
 
     BigInt hash(const BigInt &x);
+
+    // 返回 prod b^e mod N，所有 (b, e) 共用一条平方链，比逐个 modPow 再相乘少一半以上的模平方
+    // 指数不能为负数，奇数模数使用 Montgomery 约减，否则使用 Barrett 约减
+    typedef std::vector<std::pair<BigInt, BigInt>> PowTerms;
+    BigInt multiModPow(const PowTerms &terms, const BigInt &mod);
+    BigInt multiModPow(const PowTerms &terms, const MontgomeryContext &ctx);
+    BigInt multiModPow(const PowTerms &terms, const BarrettContext &ctx);
 }
\ No newline at end of file
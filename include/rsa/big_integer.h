@@ -3,10 +3,15 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstddef>
 #include "prime.h"
+#include "small_vector.h"
 
 #define BIT_USE_64
 #define BIT_USE_BARRETT
+#define BIT_USE_MONTGOMERY
+#define BIT_USE_THREADS
 
 #if defined(BIT_USE_64)
 #define BIT unsigned long long
@@ -14,21 +19,87 @@
 #define BITL 64
 #define BIT_CLZ __builtin_clzll
 #define BIT_CTZ __builtin_ctzll
+#define BIT_BSWAP __builtin_bswap64
 #else
 #define BIT unsigned int
 #define BITT unsigned long long
 #define BITL 32
 #define BIT_CLZ __builtin_clz
 #define BIT_CTZ __builtin_ctz
+#define BIT_BSWAP __builtin_bswap32
 #endif
 
+// 超过该字数的乘法使用 Karatsuba，不应小于 4
+#ifndef BIT_KARATSUBA_THRESHOLD
+#define BIT_KARATSUBA_THRESHOLD 32
+#endif
+
+// 超过该字数的乘法使用 Toom-3
+#ifndef BIT_TOOM3_THRESHOLD
+#define BIT_TOOM3_THRESHOLD 160
+#endif
+
+// 两个操作数都超过该字数的乘法使用三质数数论变换 (仅 64 位字)
+#ifndef BIT_NTT_THRESHOLD
+#define BIT_NTT_THRESHOLD 10000
+#endif
+
+// 较短操作数超过该字数时，Karatsuba/Toom-3 的子乘法在新线程中并行计算
+#ifndef BIT_PARALLEL_THRESHOLD
+#define BIT_PARALLEL_THRESHOLD 768
+#endif
+// 并行拆分的最大层数，同时运行的线程总数另受 BNLimb::set_threads 限制
+#ifndef BIT_PARALLEL_DEPTH
+#define BIT_PARALLEL_DEPTH 2
+#endif
+
+// x86-64 上编译 AVX2 降基数乘法与 Montgomery 约减内核，运行时根据 CPUID 决定是否使用
+// 实测与标量代码相当，默认关闭，由 CMake 选项 BIT_USE_AVX2 打开
+#if defined(BIT_USE_AVX2) && !(defined(BIT_USE_64) && defined(__x86_64__) && defined(__GNUC__))
+#undef BIT_USE_AVX2
+#endif
+
+// 支持 AVX2 时，字数在 [BIT_AVX2_THRESHOLD, BIT_AVX2_MAX_LIMBS] 内的乘法与 Montgomery 约减使用 AVX2 内核
+#ifndef BIT_AVX2_THRESHOLD
+#define BIT_AVX2_THRESHOLD 48
+#endif
+#ifndef BIT_AVX2_MAX_LIMBS
+#define BIT_AVX2_MAX_LIMBS 96
+#endif
+
+// 超过该字数的十进制转换使用分治
+#ifndef BIT_DEC_DC_THRESHOLD
+#define BIT_DEC_DC_THRESHOLD 30
+#endif
+
+// 内联保存的字数，足以容纳 4096 位乘积与 Montgomery 约减的中间结果
+#ifndef BIT_INLINE_LIMBS
+#define BIT_INLINE_LIMBS (2 * 4096 / BITL + 2)
+#endif
+
+typedef SmallVector<BIT, BIT_INLINE_LIMBS> digits_t;
+
 #define BIT_MAX (static_cast<BITT>(1) << BITL)
 #define BIT_MASK (BIT_MAX - 1)
 
+class MontgomeryContext;
+class BarrettContext;
+namespace BNLimb
+{
+    struct SmallDivisor;
+}
+template <int N>
+class FixedBigInt;
+
 class BigInt
 {
+    friend class MontgomeryContext;
+    friend class BarrettContext;
+    template <int N>
+    friend class FixedBigInt;
+
 protected:
-    std::vector<BIT> digits;
+    digits_t digits;
     bool sign = false;
 
 public:
@@ -36,16 +107,32 @@ public:
     BigInt(const char *str, int len = 0);
     BigInt(const std::string &str);
 
+    // 字数超过内联容量时从 res 申请存储
+    explicit BigInt(std::pmr::memory_resource *res) : digits(res) {}
+
     BigInt(const BigInt &other) : digits(other.digits), sign(other.sign) {}
-    BigInt(BigInt &&other) : digits(std::move(other.digits)), sign(other.sign) {}
-    void operator=(const BigInt &other) { digits = other.digits, sign = other.sign; }
-    void operator=(BigInt &&other) { digits = std::move(other.digits), sign = other.sign; }
-    BigInt(std::vector<BIT> &&digits, bool sign) : digits(digits), sign(sign) {}
-    BigInt(const std::vector<BIT> &digits, bool sign) : digits(digits), sign(sign) {}
+    BigInt(BigInt &&other) noexcept : digits(std::move(other.digits)), sign(other.sign) {}
+    BigInt &operator=(const BigInt &other)
+    {
+        digits = other.digits, sign = other.sign;
+        return *this;
+    }
+    BigInt &operator=(BigInt &&other) noexcept
+    {
+        digits = std::move(other.digits), sign = other.sign;
+        return *this;
+    }
+    BigInt(digits_t &&digits, bool sign) : digits(std::move(digits)), sign(sign) {}
+    BigInt(const digits_t &digits, bool sign) : digits(digits), sign(sign) {}
+    BigInt(std::vector<BIT> &&digits, bool sign) : digits(digits.data(), digits.data() + digits.size()), sign(sign) {}
+    BigInt(const std::vector<BIT> &digits, bool sign) : digits(digits.data(), digits.data() + digits.size()), sign(sign) {}
 
     int clz() const;
     int ctz() const;
     int bits() const;
+    bool bit(int i) const;
+    // 第 i 个字 (低位在前)，超出范围时为 0
+    BIT word(int i) const;
 
     // 布尔运算
     explicit operator bool() const;
@@ -61,34 +148,54 @@ public:
     bool operator<(const int other) const;
     bool operator<(const BigInt &other) const;
 
-    // 基本算术运算
-    BigInt operator+(const BigInt &other) const;
+    // 基本算术运算，右值版本直接复用左操作数的存储
+    BigInt operator+(const BigInt &other) const &;
+    BigInt operator+(const BigInt &other) &&;
+    BigInt &operator+=(const BigInt &other);
     BigInt &operator+=(const int other);
 
     BigInt operator-(const int other) const;
-    BigInt operator-(const BigInt &other) const;
+    BigInt operator-(const BigInt &other) const &;
+    BigInt operator-(const BigInt &other) &&;
+    BigInt &operator-=(const BigInt &other);
 
     BigInt operator*(const BigInt &other) const;
+    BigInt &operator*=(const BigInt &other);
+    BigInt square() const;
 
     BigInt operator/(const BigInt &other) const;
 
     prime_t operator%(const prime_t other) const;
-    BigInt operator%(const BigInt &other) const;
+    // out[j] = |*this| % ds[j]，对多个单字除数只扫描一遍数值
+    void residues(const BNLimb::SmallDivisor *ds, int m, BIT *out) const;
+    BigInt operator%(const BigInt &other) const &;
+    BigInt operator%(const BigInt &other) &&;
+    BigInt &operator%=(const BigInt &other);
 
     std::pair<BigInt, BigInt> divAndMod(const BigInt &other) const;
+    // (*this * b + c) mod m，结果在 [0, m) 内 (与 % 不同，不随符号变化)
+    // 乘法、加法与取模在同一块存储中依次完成，不产生中间的 BigInt
+    BigInt mulAddMod(const BigInt &b, const BigInt &c, const BigInt &m) const;
 
     // 基本位运算
     BigInt operator|(const unsigned int other) const;
     void operator|=(const unsigned int other);
 
-    BigInt operator>>(const int bits) const;
+    BigInt operator>>(const int bits) const &;
+    BigInt operator>>(const int bits) &&;
     BigInt &operator>>=(const int bits);
 
-    BigInt operator<<(const int bits) const;
+    BigInt operator<<(const int bits) const &;
+    BigInt operator<<(const int bits) &&;
+    BigInt &operator<<=(const int bits);
 
-    // 模幂运算 (核心)
+    // 模幂运算 (核心)，奇数模数优先使用 Montgomery 约减
     BigInt modPow(const BigInt &exp, const BigInt &mod) const
     {
+#if defined(BIT_USE_MONTGOMERY)
+        if (!mod.digits.empty() && (mod.digits.front() & 1))
+            return modPowMontgomery(exp, mod);
+#endif
 #if defined(BIT_USE_BARRETT)
         return modPowBarrett(exp, mod);
 #else
@@ -97,9 +204,22 @@ public:
     }
     BigInt modPowBasic(const BigInt &exp, const BigInt &mod) const;
     BigInt modPowBarrett(const BigInt &exp, const BigInt &mod) const;
+    BigInt modPowMontgomery(const BigInt &exp, const BigInt &mod) const;
+    BigInt modPowMontgomery(const BigInt &exp, const MontgomeryContext &ctx) const;
+    // 同 modPowMontgomery，但每步使用 CIOS 乘法/平方，供与先乘后约减的方式对比
+    BigInt modPowCios(const BigInt &exp, const MontgomeryContext &ctx) const;
 
-    // 转换函数
-    std::string toString() const;
+    // 使用预先构造的约减上下文，同一模数下多次运算只需构造一次
+    BigInt modPow(const BigInt &exp, const BarrettContext &ctx) const;
+    BigInt modPow(const BigInt &exp, const MontgomeryContext &ctx) const { return modPowMontgomery(exp, ctx); }
+    BigInt modMul(const BigInt &other, const BarrettContext &ctx) const;
+
+    // 转换函数，base 为 16 时带 0x 前缀，也支持 10
+    std::string toString(int base = 16) const;
+
+    // 大端字节序的二进制表示，toBytes 写满 len 字节 (高位补零)，放不下或为负数时抛出异常
+    static BigInt fromBytes(const uint8_t *src, size_t len);
+    void toBytes(uint8_t *dst, size_t len) const;
 
     // Just for debug
     void debug() const;
@@ -107,4 +227,81 @@ public:
     static void debug(const std::vector<BIT> &);
 };
 
+// 作用域内本线程新建的 BigInt 从 res 申请溢出存储，离开作用域时恢复原来的资源
+// 配合 std::pmr::monotonic_buffer_resource 使用时，作用域内产生的 BigInt 不能在资源释放后继续使用
+class BigIntResourceScope
+{
+private:
+    std::pmr::memory_resource *prev;
+
+public:
+    explicit BigIntResourceScope(std::pmr::memory_resource *res) : prev(small_vector_resource())
+    {
+        small_vector_resource() = res;
+    }
+    ~BigIntResourceScope() { small_vector_resource() = prev; }
+
+    BigIntResourceScope(const BigIntResourceScope &) = delete;
+    BigIntResourceScope &operator=(const BigIntResourceScope &) = delete;
+};
+
+// Montgomery 约减上下文，R = B^k (k 为模数字数)，模数必须为奇数
+// 运算数保持在 Montgomery 形式 (xR mod N) 下，每次乘法后只需一次 REDC
+class MontgomeryContext
+{
+private:
+    BigInt mod;   // N
+    BigInt r2;    // R^2 mod N
+    BIT ninv = 0; // -N^{-1} mod B
+    int k = 0;
+
+public:
+    MontgomeryContext() = default;
+    MontgomeryContext(const BigInt &mod);
+
+    const BigInt &modulus() const { return mod; }
+    const BigInt &rr() const { return r2; }
+    BIT n0inv() const { return ninv; }
+    int size() const { return k; }
+
+    // 进入/离开 Montgomery 形式
+    BigInt toMont(const BigInt &x) const;
+    BigInt fromMont(const BigInt &x) const;
+
+    // a, b 均为 Montgomery 形式，返回 abR^{-1} mod N
+    BigInt mul(const BigInt &a, const BigInt &b) const;
+    BigInt sqr(const BigInt &a) const;
+    // 返回 tR^{-1} mod N，要求 t < RN
+    BigInt redc(BigInt &&t) const;
+
+    // 与 mul/sqr 结果相同，乘法与约减逐字交替进行 (CIOS)，工作区只有 k + 2 个字
+    // 要求 a, b 已约减到 [0, N)
+    BigInt mulCios(const BigInt &a, const BigInt &b) const;
+    BigInt sqrCios(const BigInt &a) const;
+};
+
+// Barrett 约减上下文，mu = floor(B^2k / N) (k 为模数字数)
+// 对固定模数只需计算一次倒数，之后每次约减只需两次乘法
+class BarrettContext
+{
+private:
+    BigInt mod;
+    BigInt mu;
+    int k = 0;
+
+public:
+    BarrettContext() = default;
+    BarrettContext(const BigInt &mod);
+
+    const BigInt &modulus() const { return mod; }
+    int size() const { return k; }
+
+    // 返回 x mod N，要求 0 <= x < B^2k
+    BigInt reduce(const BigInt &x) const;
+
+    // a, b 均需已约减到 [0, N)
+    BigInt mul(const BigInt &a, const BigInt &b) const;
+    BigInt sqr(const BigInt &a) const;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,325 @@
+#ifndef RSA_FIXED_BIG_INTEGER_H
+#define RSA_FIXED_BIG_INTEGER_H
+
+#include "big_integer.h"
+#include "modpow.h"
+#include "limb_ops.h"
+#include <array>
+#include <cassert>
+
+// 字数在编译期已知，提示编译器展开内层循环
+#define FIXED_UNROLL _Pragma("GCC unroll 16")
+
+// 定长无符号大整数，字数 N 在编译期确定
+// 数值保存在 std::array 中，运算过程不做去零、扩容与符号处理
+template <int N>
+class FixedBigInt
+{
+public:
+    std::array<BIT, N> digits{};
+
+    constexpr FixedBigInt() = default;
+    explicit FixedBigInt(const BigInt &x)
+    {
+        assert(!x.sign && x.digits.size() <= N);
+        std::copy(x.digits.begin(), x.digits.end(), digits.begin());
+    }
+    // 高位补零扩展到更多的字，例如把 _big 字面量扩展到模数的字数
+    template <int M>
+    constexpr explicit FixedBigInt(const FixedBigInt<M> &x)
+    {
+        static_assert(M <= N, "narrowing FixedBigInt");
+        for (int i = 0; i < M; ++i)
+            digits[i] = x.digits[i];
+    }
+
+    static constexpr int size() { return N; }
+
+    BigInt toBigInt() const
+    {
+        int n = N;
+        while (n > 0 && digits[n - 1] == 0)
+            --n;
+        return BigInt(digits_t(digits.data(), digits.data() + n), false);
+    }
+
+    constexpr bool operator==(const FixedBigInt &other) const
+    {
+        for (int i = 0; i < N; ++i)
+            if (digits[i] != other.digits[i])
+                return false;
+        return true;
+    }
+    constexpr bool operator!=(const FixedBigInt &other) const { return !(*this == other); }
+
+    constexpr bool operator<(const FixedBigInt &other) const
+    {
+        for (int i = N - 1; i >= 0; --i)
+            if (digits[i] != other.digits[i])
+                return digits[i] < other.digits[i];
+        return false;
+    }
+
+    // r = a + b，返回进位
+    static BIT add(FixedBigInt &r, const FixedBigInt &a, const FixedBigInt &b)
+    {
+        BIT carry = 0;
+        FIXED_UNROLL
+        for (int i = 0; i < N; ++i)
+            carry = limb_addc(a.digits[i], b.digits[i], carry, &r.digits[i]);
+        return carry;
+    }
+
+    // r = a - b，返回借位
+    static BIT sub(FixedBigInt &r, const FixedBigInt &a, const FixedBigInt &b)
+    {
+        BIT borrow = 0;
+        FIXED_UNROLL
+        for (int i = 0; i < N; ++i)
+            borrow = limb_subb(a.digits[i], b.digits[i], borrow, &r.digits[i]);
+        return borrow;
+    }
+
+    // r = a * b
+    static void mul(std::array<BIT, 2 * N> &r, const FixedBigInt &a, const FixedBigInt &b)
+    {
+        r.fill(0);
+        for (int j = 0; j < N; ++j)
+        {
+            BITT pre = 0;
+            FIXED_UNROLL
+            for (int i = 0; i < N; ++i)
+            {
+                pre += static_cast<BITT>(a.digits[i]) * b.digits[j] + r[i + j];
+                r[i + j] = static_cast<BIT>(pre);
+                pre >>= BITL;
+            }
+            r[j + N] = static_cast<BIT>(pre);
+        }
+    }
+
+    // r = a^2，交叉项只计算一次
+    static void sqr(std::array<BIT, 2 * N> &r, const FixedBigInt &a)
+    {
+        r.fill(0);
+        for (int i = 0; i < N; ++i)
+        {
+            BITT pre = 0;
+            for (int j = i + 1; j < N; ++j)
+            {
+                pre += static_cast<BITT>(a.digits[i]) * a.digits[j] + r[i + j];
+                r[i + j] = static_cast<BIT>(pre);
+                pre >>= BITL;
+            }
+            r[i + N] = static_cast<BIT>(pre);
+        }
+
+        BIT top = 0;
+        FIXED_UNROLL
+        for (int i = 0; i < 2 * N; ++i)
+        {
+            BIT now = r[i] >> (BITL - 1);
+            r[i] = (r[i] << 1) | top;
+            top = now;
+        }
+
+        BIT carry = 0;
+        FIXED_UNROLL
+        for (int i = 0; i < N; ++i)
+        {
+            BIT hi;
+            BIT lo = limb_mul(a.digits[i], a.digits[i], &hi);
+            carry = limb_addc(r[2 * i], lo, carry, &r[2 * i]);
+            carry = limb_addc(r[2 * i + 1], hi, carry, &r[2 * i + 1]);
+        }
+    }
+};
+
+// 定长 Montgomery 约减，参数取自对应的 MontgomeryContext
+template <int N>
+class FixedMontgomery
+{
+private:
+    FixedBigInt<N> mod;
+    FixedBigInt<N> r2;
+    BIT ninv;
+
+    // r = tR^{-1} mod N，要求 t < RN
+    void redc(FixedBigInt<N> &r, std::array<BIT, 2 * N> &t) const
+    {
+        BIT top = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            BIT m = t[i] * ninv;
+            BITT pre = 0;
+            FIXED_UNROLL
+            for (int j = 0; j < N; ++j)
+            {
+                pre += static_cast<BITT>(m) * mod.digits[j] + t[i + j];
+                t[i + j] = static_cast<BIT>(pre);
+                pre >>= BITL;
+            }
+            top = limb_addc(t[i + N], static_cast<BIT>(pre), top, &t[i + N]);
+        }
+
+        std::copy(t.begin() + N, t.end(), r.digits.begin());
+        if (top || !(r < mod))
+            FixedBigInt<N>::sub(r, r, mod);
+    }
+
+public:
+    explicit FixedMontgomery(const MontgomeryContext &ctx)
+        : mod(ctx.modulus()), r2(ctx.rr()), ninv(ctx.n0inv())
+    {
+        assert(ctx.size() == N);
+    }
+    // 模数为编译期常量 (如 _big 字面量) 时直接由定长数值构造，最高字必须非零
+    explicit FixedMontgomery(const FixedBigInt<N> &mod)
+        : FixedMontgomery(MontgomeryContext(mod.toBigInt())) {}
+
+    FixedBigInt<N> mul(const FixedBigInt<N> &a, const FixedBigInt<N> &b) const
+    {
+        std::array<BIT, 2 * N> t;
+        FixedBigInt<N>::mul(t, a, b);
+        FixedBigInt<N> r;
+        redc(r, t);
+        return r;
+    }
+
+    FixedBigInt<N> sqr(const FixedBigInt<N> &a) const
+    {
+        std::array<BIT, 2 * N> t;
+        FixedBigInt<N>::sqr(t, a);
+        FixedBigInt<N> r;
+        redc(r, t);
+        return r;
+    }
+
+    // 要求 0 <= x < N
+    FixedBigInt<N> toMont(const BigInt &x) const
+    {
+        return mul(FixedBigInt<N>(x), r2);
+    }
+
+    BigInt fromMont(const FixedBigInt<N> &x) const
+    {
+        std::array<BIT, 2 * N> t{};
+        std::copy(x.digits.begin(), x.digits.end(), t.begin());
+        FixedBigInt<N> r;
+        redc(r, t);
+        return r.toBigInt();
+    }
+
+    BigInt modPow(const BigInt &x, const BigInt &exp) const
+    {
+        if (!exp)
+            return BigInt(1);
+
+        auto mulf = [this](const FixedBigInt<N> &a, const FixedBigInt<N> &b)
+        { return mul(a, b); };
+        auto sqrf = [this](const FixedBigInt<N> &a)
+        { return sqr(a); };
+        return fromMont(slideWindowPow(toMont(x), exp, mulf, sqrf));
+    }
+};
+
+// 编译期解析的大整数字面量，如 0xC2B7..._big、65537_big，结果为字数恰好够用的 FixedBigInt
+// 支持 C++ 整数字面量的全部写法 (0x / 0b / 0 前缀与 ' 分隔符)，不受 unsigned long long 宽度限制
+namespace BNLiteral
+{
+    template <char... Cs>
+    struct Chars
+    {
+        static constexpr char str[sizeof...(Cs)] = {Cs...};
+        static constexpr int len = sizeof...(Cs);
+    };
+
+    constexpr int base(const char *s, int n)
+    {
+        if (n >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+            return 16;
+        if (n >= 2 && s[0] == '0' && (s[1] == 'b' || s[1] == 'B'))
+            return 2;
+        return n >= 2 && s[0] == '0' ? 8 : 10;
+    }
+
+    constexpr int prefix(const char *s, int n)
+    {
+        int b = base(s, n);
+        return b == 16 || b == 2 ? 2 : 0;
+    }
+
+    constexpr int digit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    // 字面量是否只由当前进制的数字与分隔符组成 (排除浮点字面量)
+    constexpr bool valid(const char *s, int n)
+    {
+        int b = base(s, n), digits = 0;
+        for (int i = prefix(s, n); i < n; ++i)
+        {
+            if (s[i] == '\'')
+                continue;
+            int d = digit(s[i]);
+            if (d < 0 || d >= b)
+                return false;
+            ++digits;
+        }
+        return digits > 0;
+    }
+
+    // 按位数估计所需字数，十进制每位按 log2(10) < 3.33 位计
+    constexpr int limbs(const char *s, int n)
+    {
+        int b = base(s, n), digits = 0;
+        for (int i = prefix(s, n); i < n; ++i)
+            digits += s[i] != '\'';
+        int bits = b == 16 ? 4 * digits : b == 8 ? 3 * digits : b == 2 ? digits : digits * 333 / 100 + 1;
+        int k = (bits + BITL - 1) / BITL;
+        return k > 0 ? k : 1;
+    }
+
+    // 逐位计算 r = r * base + d
+    template <int N>
+    constexpr FixedBigInt<N> parse(const char *s, int n)
+    {
+        FixedBigInt<N> r;
+        int b = base(s, n);
+        for (int i = prefix(s, n); i < n; ++i)
+        {
+            if (s[i] == '\'')
+                continue;
+            BITT carry = digit(s[i]);
+            for (int j = 0; j < N; ++j)
+            {
+                carry += static_cast<BITT>(r.digits[j]) * b;
+                r.digits[j] = static_cast<BIT>(carry);
+                carry >>= BITL;
+            }
+        }
+        return r;
+    }
+}
+
+template <char... Cs>
+constexpr auto operator""_big()
+{
+    using L = BNLiteral::Chars<Cs...>;
+    static_assert(BNLiteral::valid(L::str, L::len), "_big only accepts integer literals");
+    return BNLiteral::parse<BNLiteral::limbs(L::str, L::len)>(L::str, L::len);
+}
+
+// 模数为奇数且字数与常见密钥长度 (1024/2048/3072/4096 位) 一致时使用定长实现
+// 其余情况回退到 BigInt::modPow
+BigInt modPowFixed(const BigInt &x, const BigInt &exp, const BigInt &mod);
+BigInt modPowFixed(const BigInt &x, const BigInt &exp, const MontgomeryContext &ctx);
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef RSA_LIMB_H
+#define RSA_LIMB_H
+
+#include "big_integer.h"
+
+// 无符号字数组运算层，风格参考 GMP 的 mpn 接口
+// 数值以 (BIT *, int) 表示，低位在前，所有输出缓冲区由调用者提供且长度足够
+// 除特别说明外，输出可以与输入完全重叠 (起始地址相同)，但不能部分重叠
+// 乘法与除法内部的临时空间使用 digits_t，常见密钥长度下不会申请堆内存
+namespace BNLimb
+{
+    // 比较等长的 a 与 b，返回 1, 0, -1
+    int cmp(const BIT *a, const BIT *b, int n);
+
+    // 去掉高位的零字后的长度
+    int normalize(const BIT *a, int n);
+
+    // r[0, n) = a + b，返回进位
+    BIT add_n(BIT *r, const BIT *a, const BIT *b, int n);
+    // r[0, na) = a + b，要求 na >= nb，返回进位
+    BIT add(BIT *r, const BIT *a, int na, const BIT *b, int nb);
+    // r[0, n) = a + b，返回进位
+    BIT add_1(BIT *r, const BIT *a, int n, BIT b);
+
+    // r[0, n) = a - b，返回借位
+    BIT sub_n(BIT *r, const BIT *a, const BIT *b, int n);
+    // r[0, na) = a - b，要求 na >= nb，返回借位
+    BIT sub(BIT *r, const BIT *a, int na, const BIT *b, int nb);
+    // r[0, n) = a - b，返回借位
+    BIT sub_1(BIT *r, const BIT *a, int n, BIT b);
+
+    // r[0, n) = a * b，返回最高位字
+    BIT mul_1(BIT *r, const BIT *a, int n, BIT b);
+    // r[0, n) += a * b，返回最高位字
+    BIT addmul_1(BIT *r, const BIT *a, int n, BIT b);
+    // r[0, n) -= a * b，返回借位
+    BIT submul_1(BIT *r, const BIT *a, int n, BIT b);
+
+    // r[0, n) = a << s 或 a >> s，0 < s < BITL，返回移出的字
+    BIT lshift(BIT *r, const BIT *a, int n, int s);
+    BIT rshift(BIT *r, const BIT *a, int n, int s);
+
+    // 以下乘法的 r 不能与输入重叠
+    // r[0, na + nb) = a * b，逐行乘加
+    void mul_basecase(BIT *r, const BIT *a, int na, const BIT *b, int nb);
+    // r[0, 2n) = a^2
+    void sqr_basecase(BIT *r, const BIT *a, int n);
+    // r[0, na + nb) = a * b，根据规模选择 Karatsuba/Toom-3 等算法
+    void mul(BIT *r, const BIT *a, int na, const BIT *b, int nb);
+    // r[0, 2n) = a^2
+    void sqr(BIT *r, const BIT *a, int n);
+    // r[0, n) = a * b mod B^n，只计算乘积的低 n 个字
+    void mul_lo(BIT *r, const BIT *a, int na, const BIT *b, int nb, int n);
+#if defined(BIT_USE_THREADS)
+    // 设置大乘法并行时同时运行的线程总数上限 (含调用者)，0 (默认) 表示 std::thread::hardware_concurrency()，1 表示不并行
+    void set_threads(int n);
+#endif
+
+#if defined(BIT_USE_64)
+    // r[0, na + nb) = a * b，三个质数上的数论变换加 CRT 还原，a 与 b 相同时只做一次正变换
+    void mul_ntt(BIT *r, const BIT *a, int na, const BIT *b, int nb);
+#endif
+
+    // 预先求出倒数的单字除数 (Möller-Granlund)，之后每个字的除法只需两次乘法
+    // d 左移 s 位规格化为 dn (最高位为 1)，v = floor((B^2 - 1) / dn) - B
+    struct SmallDivisor
+    {
+        BIT d = 1, dn = static_cast<BIT>(1) << (BITL - 1), v = ~static_cast<BIT>(0);
+        int s = BITL - 1;
+
+        SmallDivisor() = default;
+        explicit SmallDivisor(BIT d);
+
+        // 要求 u1 < dn，返回 (u1 * B + u0) / dn，余数写入 r
+        BIT divrem_norm(BIT u1, BIT u0, BIT &r) const
+        {
+            BITT q = static_cast<BITT>(v) * u1 + ((static_cast<BITT>(u1) << BITL) | u0);
+            BIT q1 = static_cast<BIT>(q >> BITL) + 1, q0 = static_cast<BIT>(q);
+            BIT rem = u0 - q1 * dn;
+            if (rem > q0)
+                --q1, rem += dn;
+            if (rem >= dn)
+                ++q1, rem -= dn;
+            r = rem;
+            return q1;
+        }
+
+        // 规格化后的被除数中，以 hi 为当前字、lo 为下一字时的第 i 个字
+        BIT shifted(BIT hi, BIT lo) const
+        {
+            return (hi << s) | ((lo >> 1) >> (BITL - 1 - s));
+        }
+    };
+
+    // q[0, n) = a / b，返回 a % b
+    BIT divrem_1(BIT *q, const BIT *a, int n, BIT b);
+    BIT divrem_1(BIT *q, const BIT *a, int n, const SmallDivisor &d);
+    // 返回 a % d
+    BIT mod_1(const BIT *a, int n, const SmallDivisor &d);
+    // out[j] = a % ds[j]，只扫描 a 一次，m 个余数的计算互不依赖，可以交错执行
+    void mod_1s(BIT *out, const BIT *a, int n, const SmallDivisor *ds, int m);
+    // q[0, na - nb + 1) = a / b，r[0, nb) = a % b
+    // 要求 na >= nb >= 1 且 b 的最高字非零，q 与 r 不能与输入重叠
+    void divrem(BIT *q, BIT *r, const BIT *a, int na, const BIT *b, int nb);
+    // 原地取模，a[0, na + 1) 均可写，结束后 a[0, nb) = a % b，其余字无意义
+    // 要求 na >= nb >= 1 且 b 的最高字非零，b 不能与 a 重叠
+    void mod(BIT *a, int na, const BIT *b, int nb);
+
+    // CIOS Montgomery 乘法，逐字交替做乘加与约减，不生成 2k 字的乘积
+    // r[0, k) = a * b * B^{-k} mod n，要求 a, b < n 且均为 k 字，n 为奇数，ninv = -n^{-1} mod B
+    // 工作区只有 k + 2 个字，r 可以与 a 或 b 重叠
+    void mont_mul(BIT *r, const BIT *a, const BIT *b, const BIT *n, int k, BIT ninv);
+    // r[0, k) = a^2 * B^{-k} mod n，交叉项只乘一次，要求同 mont_mul
+    void mont_sqr(BIT *r, const BIT *a, const BIT *n, int k, BIT ninv);
+}
+
+#if defined(BIT_USE_AVX2)
+// AVX2 降基数内核，见 big_integer_avx2.cpp，调用前需确认 bit_cpu_has_avx2()
+bool bit_cpu_has_avx2();
+// res[0, na + nb) = a * b，要求 nb <= na <= 2 * BIT_AVX2_MAX_LIMBS 且 nb <= BIT_AVX2_MAX_LIMBS
+void unsign_mul_avx2(const BIT *a, int na, const BIT *b, int nb, BIT *res);
+// r[0, k + 1) = t * B^{-k} mod N (小于 2N)，要求 t < B^k * N 且 k <= BIT_AVX2_MAX_LIMBS
+void redc_avx2(BIT *r, const BIT *t, int nt, const BIT *n, int k, BIT ninv);
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef RSA_LIMB_OPS_H
+#define RSA_LIMB_OPS_H
+
+#include "big_integer.h"
+
+// 单字进位链原语
+// x86-64 上使用 _addcarry_u64/_subborrow_u64，编译时开启 BMI2/ADX 则使用 MULX 与 ADCX
+// 其余平台回退到双字长整数运算
+#if defined(BIT_USE_64) && defined(__x86_64__)
+#include <immintrin.h>
+#define BIT_USE_ADDCARRY
+#endif
+
+// *r = a + b + c，返回进位，c 只能为 0 或 1
+static inline BIT
+limb_addc(BIT a, BIT b, BIT c, BIT *r)
+{
+#if defined(BIT_USE_ADDCARRY) && defined(__ADX__)
+    return _addcarryx_u64(static_cast<unsigned char>(c), a, b, r);
+#elif defined(BIT_USE_ADDCARRY)
+    return _addcarry_u64(static_cast<unsigned char>(c), a, b, r);
+#else
+    BITT s = static_cast<BITT>(a) + b + c;
+    *r = static_cast<BIT>(s);
+    return static_cast<BIT>(s >> BITL);
+#endif
+}
+
+// *r = a - b - c，返回借位，c 只能为 0 或 1
+static inline BIT
+limb_subb(BIT a, BIT b, BIT c, BIT *r)
+{
+#if defined(BIT_USE_ADDCARRY)
+    return _subborrow_u64(static_cast<unsigned char>(c), a, b, r);
+#else
+    BIT d = a - b;
+    BIT borrow = (a < b) | (d < c);
+    *r = d - c;
+    return borrow;
+#endif
+}
+
+// 返回 a * b 的低字，*hi 为高字
+static inline BIT
+limb_mul(BIT a, BIT b, BIT *hi)
+{
+#if defined(BIT_USE_ADDCARRY) && defined(__BMI2__)
+    return _mulx_u64(a, b, hi);
+#else
+    BITT p = static_cast<BITT>(a) * b;
+    *hi = static_cast<BIT>(p >> BITL);
+    return static_cast<BIT>(p);
+#endif
+}
+
+// r[0, n) = a[0, n) * b，返回最高位字
+static inline BIT
+limb_mul_row(BIT *r, const BIT *a, int n, BIT b)
+{
+    BITT pre = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        pre += static_cast<BITT>(a[i]) * b;
+        r[i] = static_cast<BIT>(pre);
+        pre >>= BITL;
+    }
+    return static_cast<BIT>(pre);
+}
+
+// r[0, n) += a[0, n) * b，返回最高位字
+// 双字累加器在 GCC 下生成 mul/add/adc 序列，实测快于以 ADCX/ADOX 分成两条进位链的写法
+static inline BIT
+limb_addmul_row(BIT *r, const BIT *a, int n, BIT b)
+{
+    BITT pre = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        pre += static_cast<BITT>(a[i]) * b + r[i];
+        r[i] = static_cast<BIT>(pre);
+        pre >>= BITL;
+    }
+    return static_cast<BIT>(pre);
+}
+
+// r[0, n) -= a[0, n) * b，返回借位 (不超过 B - 1)
+static inline BIT
+limb_submul_row(BIT *r, const BIT *a, int n, BIT b)
+{
+    BIT cl = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        BIT hi;
+        BIT lo = limb_mul(a[i], b, &hi);
+        cl = hi + limb_addc(lo, cl, 0, &lo);
+        cl += limb_subb(r[i], lo, 0, &r[i]);
+    }
+    return cl;
+}
+
+#endif
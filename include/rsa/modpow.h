@@ -0,0 +1,144 @@
+#ifndef RSA_MODPOW_H
+#define RSA_MODPOW_H
+
+#include "big_integer.h"
+#include <vector>
+#include <algorithm>
+
+// 根据指数位数选择滑动窗口宽度，参考 openssl 的 BN_window_bits_for_exponent_size
+inline int
+getWindowBits(int bits)
+{
+    if (bits > 671)
+        return 6;
+    if (bits > 239)
+        return 5;
+    if (bits > 79)
+        return 4;
+    if (bits > 23)
+        return 3;
+    return 1;
+}
+
+// 从高位到低位的滑动窗口模幂，mul/sqr 为某种约减方式下的模乘与模平方
+// T 为该约减方式下的数值类型，base 需已处于对应表示下，exp 不能为 0
+template <typename T, typename Mul, typename Sqr>
+T slideWindowPow(const T &base, const BigInt &exp, Mul mul, Sqr sqr)
+{
+    int bits = exp.bits();
+    int w = getWindowBits(bits);
+
+    // table[i] = base^(2i+1)
+    std::vector<T> table(1 << (w - 1));
+    table[0] = base;
+    if (w > 1)
+    {
+        T base2 = sqr(base);
+        for (size_t i = 1; i < table.size(); ++i)
+            table[i] = mul(table[i - 1], base2);
+    }
+
+    T res;
+    bool started = false;
+    for (int i = bits - 1; i >= 0;)
+    {
+        if (!exp.bit(i))
+        {
+            res = sqr(res);
+            --i;
+            continue;
+        }
+
+        int j = std::max(i - w + 1, 0);
+        while (!exp.bit(j))
+            ++j;
+        int val = 0;
+        for (int l = i; l >= j; --l)
+            val = (val << 1) | exp.bit(l);
+
+        if (started)
+        {
+            for (int l = j; l <= i; ++l)
+                res = sqr(res);
+            res = mul(res, table[val >> 1]);
+        }
+        else
+        {
+            res = table[val >> 1];
+            started = true;
+        }
+        i = j - 1;
+    }
+    return res;
+}
+
+// 多个底数共用一条平方链的交错滑动窗口 (Straus/Shamir)，返回 prod bases[k]^exps[k]
+// 每个底数按各自指数位数取窗口并建奇数次幂表，窗口在其最低位处乘入，exps 均不能为 0
+template <typename T, typename Mul, typename Sqr>
+T interleavedPow(const std::vector<T> &bases, const std::vector<BigInt> &exps, Mul mul, Sqr sqr)
+{
+    int n = bases.size();
+    int bits = 0;
+    for (const BigInt &e : exps)
+        bits = std::max(bits, e.bits());
+
+    // tables[k][i] = bases[k]^(2i+1)，wins[k][j] 为在第 j 位结束的窗口值 (0 表示没有)
+    std::vector<std::vector<T>> tables(n);
+    std::vector<std::vector<int>> wins(n, std::vector<int>(bits, 0));
+    for (int k = 0; k < n; ++k)
+    {
+        const BigInt &exp = exps[k];
+        int w = getWindowBits(exp.bits());
+
+        std::vector<T> &table = tables[k];
+        table.resize(1 << (w - 1));
+        table[0] = bases[k];
+        if (w > 1)
+        {
+            T base2 = sqr(bases[k]);
+            for (size_t i = 1; i < table.size(); ++i)
+                table[i] = mul(table[i - 1], base2);
+        }
+
+        for (int i = exp.bits() - 1; i >= 0;)
+        {
+            if (!exp.bit(i))
+            {
+                --i;
+                continue;
+            }
+            int j = std::max(i - w + 1, 0);
+            while (!exp.bit(j))
+                ++j;
+            int val = 0;
+            for (int l = i; l >= j; --l)
+                val = (val << 1) | exp.bit(l);
+            wins[k][j] = val;
+            i = j - 1;
+        }
+    }
+
+    T res;
+    bool started = false;
+    for (int i = bits - 1; i >= 0; --i)
+    {
+        if (started)
+            res = sqr(res);
+        for (int k = 0; k < n; ++k)
+        {
+            int val = wins[k][i];
+            if (!val)
+                continue;
+            if (started)
+                res = mul(res, tables[k][val >> 1]);
+            else
+            {
+                res = tables[k][val >> 1];
+                started = true;
+            }
+        }
+    }
+    return res;
+}
+
+#endif
@@ -12,6 +12,9 @@ namespace BNRandom
 
     BigInt getRandInt(int bits, bool keep = true);
     BigInt getRandPrime(int bits, bool safe = false);
+
+    // 以 2 为底的强伪素数测试，质数一定通过，通过的合数 (强伪素数) 极少
+    bool isStrongProbablePrime2(const BigInt &w);
 }
 
 #endif
\ No newline at end of file
@@ -6,6 +6,13 @@
 #include "random.h"
 #include <memory>
 
+// 密钥持有的约减上下文，与 BigInt::modPow 选择的约减方式一致
+#if defined(BIT_USE_MONTGOMERY)
+typedef MontgomeryContext ModContext;
+#else
+typedef BarrettContext ModContext;
+#endif
+
 class RSAPrivateKey
 {
 private:
@@ -20,6 +27,13 @@ private:
     BigInt dq;
     BigInt nm;
 
+    // 加载密钥时构造，之后每个分组直接复用
+    ModContext nctx;
+    ModContext pctx;
+    ModContext qctx;
+
+    void initContext();
+
 public:
     RSAPrivateKey() = delete;
     RSAPrivateKey(int bits);
@@ -40,11 +54,12 @@ class RSAPublicKey
 private:
     BigInt n;
     BigInt e;
+    ModContext nctx;
 
 public:
     RSAPublicKey() = delete;
-    RSAPublicKey(const BigInt &n, const BigInt &e) : n(n), e(e) {}
-    RSAPublicKey(BigInt &&n, BigInt &&e) : n(n), e(e) {}
+    RSAPublicKey(const BigInt &n, const BigInt &e) : n(n), e(e), nctx(n) {}
+    RSAPublicKey(BigInt &&n, BigInt &&e) : n(std::move(n)), e(std::move(e)), nctx(this->n) {}
     RSAPublicKey(const std::string &file);
 
     int bits() const { return n.bits(); }
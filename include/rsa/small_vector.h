@@ -0,0 +1,178 @@
+#ifndef RSA_SMALL_VECTOR_H
+#define RSA_SMALL_VECTOR_H
+
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <memory_resource>
+
+// 本线程新建的 SmallVector 溢出到堆时默认使用的内存资源，nullptr 表示 new/delete
+inline std::pmr::memory_resource *&
+small_vector_resource()
+{
+    thread_local std::pmr::memory_resource *res = nullptr;
+    return res;
+}
+
+// 带内联缓冲区的顺序容器，元素个数不超过 N 时不申请堆内存
+// 只用于保存字 (平凡可复制类型)，接口为 std::vector 的子集
+// 溢出存储来自构造时的内存资源，移动赋值仅在资源相同时接管对方的存储，与 std::pmr 容器一致
+template <typename T, int N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only holds trivially copyable types");
+
+private:
+    T *ptr;
+    int len = 0;
+    int cap = N;
+    std::pmr::memory_resource *res = small_vector_resource();
+    T buf[N];
+
+    bool isInline() const { return ptr == buf; }
+
+    T *allocate(int n)
+    {
+        if (res)
+            return static_cast<T *>(res->allocate(sizeof(T) * n, alignof(T)));
+        return new T[n];
+    }
+
+    void deallocate(T *p, int n)
+    {
+        if (res)
+            res->deallocate(p, sizeof(T) * n, alignof(T));
+        else
+            delete[] p;
+    }
+
+    void release()
+    {
+        if (!isInline())
+            deallocate(ptr, cap);
+        ptr = buf, cap = N;
+    }
+
+    void grow(int n)
+    {
+        if (n <= cap)
+            return;
+        int ncap = std::max(n, cap * 2);
+        T *nptr = allocate(ncap);
+        std::memcpy(nptr, ptr, sizeof(T) * len);
+        if (!isInline())
+            deallocate(ptr, cap);
+        ptr = nptr, cap = ncap;
+    }
+
+    void assign(const T *first, int n)
+    {
+        if (n > cap)
+        {
+            release();
+            ptr = allocate(n), cap = n;
+        }
+        std::memcpy(ptr, first, sizeof(T) * n);
+        len = n;
+    }
+
+    void steal(SmallVector &&other)
+    {
+        if (other.isInline())
+        {
+            std::memcpy(buf, other.buf, sizeof(T) * other.len);
+            ptr = buf, cap = N;
+        }
+        else
+        {
+            ptr = other.ptr, cap = other.cap;
+            other.ptr = other.buf, other.cap = N;
+        }
+        len = other.len;
+        other.len = 0;
+    }
+
+public:
+    typedef T value_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    SmallVector() : ptr(buf) {}
+    explicit SmallVector(std::pmr::memory_resource *res) : ptr(buf), res(res) {}
+    explicit SmallVector(int n, const T &value = T()) : ptr(buf) { resize(n, value); }
+    SmallVector(const T *first, const T *last) : ptr(buf) { assign(first, last - first); }
+    SmallVector(const SmallVector &other) : ptr(buf) { assign(other.ptr, other.len); }
+    SmallVector(SmallVector &&other) noexcept : ptr(buf), res(other.res) { steal(std::move(other)); }
+    ~SmallVector() { release(); }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+            assign(other.ptr, other.len);
+        return *this;
+    }
+    SmallVector &operator=(SmallVector &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        if (res == other.res)
+        {
+            release();
+            steal(std::move(other));
+        }
+        else
+            assign(other.ptr, other.len);
+        return *this;
+    }
+
+    std::pmr::memory_resource *resource() const { return res; }
+
+    int size() const { return len; }
+    int capacity() const { return cap; }
+    bool empty() const { return len == 0; }
+
+    T *data() { return ptr; }
+    const T *data() const { return ptr; }
+    T &operator[](int i) { return ptr[i]; }
+    const T &operator[](int i) const { return ptr[i]; }
+    T &front() { return ptr[0]; }
+    const T &front() const { return ptr[0]; }
+    T &back() { return ptr[len - 1]; }
+    const T &back() const { return ptr[len - 1]; }
+
+    iterator begin() { return ptr; }
+    iterator end() { return ptr + len; }
+    const_iterator begin() const { return ptr; }
+    const_iterator end() const { return ptr + len; }
+
+    void reserve(int n) { grow(n); }
+    void clear() { len = 0; }
+
+    void resize(int n, const T &value = T())
+    {
+        grow(n);
+        if (n > len)
+            std::fill(ptr + len, ptr + n, value);
+        len = n;
+    }
+
+    void push_back(const T &value)
+    {
+        T v = value;
+        if (len == cap)
+            grow(len + 1);
+        ptr[len++] = v;
+    }
+
+    void pop_back() { --len; }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        int l = first - ptr, r = last - ptr;
+        std::memmove(ptr + l, ptr + r, sizeof(T) * (len - r));
+        len -= r - l;
+        return ptr + l;
+    }
+};
+
+#endif
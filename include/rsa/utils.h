@@ -11,10 +11,10 @@ private:
     int length;
     int lenlength;
     void init();
-    void clear();
 
 public:
-    BNUtils(int sz, int length, int lenlength) : sz(sz), length(length), lenlength(lenlength) { init(); };
+    BNUtils(int sz, int length, int lenlength, std::pmr::memory_resource *res = small_vector_resource())
+        : BigInt(res), sz(sz), length(length), lenlength(lenlength) { init(); };
     BNUtils &operator=(BigInt &&x)
     {
         BigInt::operator=(std::move(x));
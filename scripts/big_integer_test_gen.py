@@ -56,6 +56,19 @@ def generate_test(operator, number, max_digits, output_dir="/tmp"):
         f.flush()
 
 
+def generate_sqr_test(number, max_digits, output_dir="/tmp"):
+    with open(output_dir + f"/big_integer_test_sqr", "w") as f:
+        for _ in range(number):
+            a_hex = generate_random_hex(max_digits)
+            a_int = hex_to_int(a_hex)
+
+            if random.choice([True, False]):
+                a_hex = "-" + a_hex
+
+            f.write("\n".join([a_hex, int_to_hex(a_int * a_int)]) + "\n")
+        f.flush()
+
+
 def generate_div_test(number, max_digits, output_dir="/tmp"):
     with open(output_dir + f"/big_integer_test_div", "w") as f:
         for _ in range(number):
@@ -108,6 +121,34 @@ def generate_rshift_test(number, max_digits, output_dir="/tmp"):
         f.flush()
 
 
+def generate_lshift_test(number, max_digits, output_dir="/tmp"):
+    with open(output_dir + f"/big_integer_test_lshift", "w") as f:
+        for _ in range(number):
+            a_hex = generate_random_hex(max_digits)
+            b = random.randint(0, max_digits // 60)
+
+            a_int = hex_to_int(a_hex)
+
+            c_int = a_int * (2**b)
+
+            f.write("\n".join([a_hex, str(b), int_to_hex(c_int)]) + "\n")
+        f.flush()
+
+
+def generate_dec_test(number, max_digits, output_dir="/tmp"):
+    with open(output_dir + f"/big_integer_test_dec", "w") as f:
+        for _ in range(number):
+            a_hex = generate_random_hex(max_digits)
+            a_int = hex_to_int(a_hex)
+
+            if random.choice([True, False]):
+                a_hex = "-" + a_hex
+                a_int = -a_int
+
+            f.write("\n".join([a_hex, str(a_int)]) + "\n")
+        f.flush()
+
+
 def generate_bigcmp_test(number, max_digits, output_dir="/tmp"):
     with open(output_dir + f"/big_integer_test_bigcmp", "w") as f:
         for _ in range(number):
@@ -138,8 +179,8 @@ def main():
     parser = argparse.ArgumentParser(description="生成大整数运算测试用例")
     parser.add_argument(
         "operation",
-        choices=["add", "sub", "mul", "div", "rshift", "modpow", "bigcmp"],
-        help="运算类型: add(加), sub(减), mul(乘), div(除), rshift(右移), modpow(指数模), bigcmp(比较)",
+        choices=["add", "sub", "mul", "sqr", "div", "rshift", "lshift", "modpow", "bigcmp", "dec"],
+        help="运算类型: add(加), sub(减), mul(乘), sqr(平方), div(除), rshift(右移), lshift(左移), modpow(指数模), bigcmp(比较), dec(十进制转换)",
     )
     parser.add_argument(
         "-n", "--number", type=int, default=1, help="生成测试用例的数量 (默认: 1)"
@@ -160,14 +201,20 @@ def main():
 
     if args.operation in ["add", "sub", "mul"]:
         generate_test(args.operation, args.number, args.max_digits)
+    elif args.operation == "sqr":
+        generate_sqr_test(args.number, args.max_digits)
     elif args.operation == "div":
         generate_div_test(args.number, args.max_digits)
     elif args.operation == "rshift":
         generate_rshift_test(args.number, args.max_digits)
+    elif args.operation == "lshift":
+        generate_lshift_test(args.number, args.max_digits)
     elif args.operation == "modpow":
         generate_modpow_test(args.number, args.max_digits)
     elif args.operation == "bigcmp":
         generate_bigcmp_test(args.number, args.max_digits)
+    elif args.operation == "dec":
+        generate_dec_test(args.number, args.max_digits)
 
 
 if __name__ == "__main__":
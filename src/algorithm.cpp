@@ -1,20 +1,90 @@
 #include <rsa/algorithm.h>
+#include <rsa/modpow.h>
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 namespace BNAlgo
 {
-    std::tuple<bool, BigInt, BigInt> inv_exgcd(const BigInt &a, const BigInt &b)
+    // Lehmer 算法每轮使用的前导位数，保证余因子与中间量在 long long 范围内
+#define LEHMER_BITS 62
+
+    // 返回 (x >> s) 的低 LEHMER_BITS 位
+    static long long
+    leading_bits(const BigInt &x, int s)
     {
-        if (b == 0)
-            return std::make_tuple(a == 1, BigInt(1), BigInt());
+        __uint128_t acc = 0;
+        int lo = s / BITL;
+        for (int k = lo + 128 / BITL - 1; k >= lo; --k)
+            acc = (acc << BITL) | x.word(k);
+        acc >>= s % BITL;
+        return static_cast<long long>(acc & ((1ull << LEHMER_BITS) - 1));
+    }
 
-        auto [div, mod] = a.divAndMod(b);
-        auto [ret, x, y] = inv_exgcd(b, mod);
-        if (ret == false)
-            return std::make_tuple(false, std::move(x), std::move(y));
+    static BigInt
+    from_small(long long v)
+    {
+        if (v == 0)
+            return BigInt();
+        unsigned long long mag = v < 0 ? -static_cast<unsigned long long>(v) : v;
+        return BigInt(std::vector<BIT>{static_cast<BIT>(mag)}, v < 0);
+    }
+
+    // 返回 x * p + y * q
+    static BigInt
+    combine(const BigInt &x, long long p, const BigInt &y, long long q)
+    {
+        return x * from_small(p) + y * from_small(q);
+    }
+
+    // 迭代的 Lehmer 扩展欧几里得算法，返回 (gcd(a, b) == 1, x, y)，其中 ax + by = gcd(a, b)
+    // 每轮只用 a, b 的前导位模拟若干步欧几里得，累积成 2x2 矩阵后一次作用到大整数上
+    // 单字估计无法确定商时退回一次完整的带余除法
+    std::tuple<bool, BigInt, BigInt> inv_exgcd(const BigInt &a0, const BigInt &b0)
+    {
+        BigInt a = a0, b = b0;
+        BigInt xa(1), ya, xb, yb(1);
+
+        while (b != 0)
+        {
+            int s = std::max(a.bits(), b.bits()) - LEHMER_BITS;
+            s = std::max(s, 0);
+            long long ah = leading_bits(a, s), bh = leading_bits(b, s);
+            long long A = 1, B = 0, C = 0, D = 1;
+
+            // Knuth 4.5.2 Algorithm L，两种截断下的商相同时才接受
+            while (bh + C != 0 && bh + D != 0)
+            {
+                long long q = (ah + A) / (bh + C);
+                if (q != (ah + B) / (bh + D))
+                    break;
+                long long t;
+                t = A - q * C, A = C, C = t;
+                t = B - q * D, B = D, D = t;
+                t = ah - q * bh, ah = bh, bh = t;
+            }
+
+            if (B == 0)
+            {
+                auto [q, r] = a.divAndMod(b);
+                a = std::move(b), b = std::move(r);
+                BigInt t = xa - q * xb;
+                xa = std::move(xb), xb = std::move(t);
+                t = ya - q * yb;
+                ya = std::move(yb), yb = std::move(t);
+                continue;
+            }
+
+            BigInt na = combine(a, A, b, B), nb = combine(a, C, b, D);
+            a = std::move(na), b = std::move(nb);
+            BigInt nxa = combine(xa, A, xb, B), nxb = combine(xa, C, xb, D);
+            xa = std::move(nxa), xb = std::move(nxb);
+            BigInt nya = combine(ya, A, yb, B), nyb = combine(ya, C, yb, D);
+            ya = std::move(nya), yb = std::move(nyb);
+        }
 
-        BigInt xy = x - div * y;
-        return std::make_tuple(true, std::move(y), std::move(xy));
+        return std::make_tuple(a == 1, std::move(xa), std::move(ya));
     }
 
     BigInt inv(const BigInt &a, const BigInt &n, bool is_prime)
@@ -30,6 +100,71 @@ namespace BNAlgo
         return x;
     }
 
+    // 去掉指数为 0 的项并把底数约减到 [0, N)，结果由 conv 转换到约减方式的表示下
+    template <typename Conv>
+    static void
+    prepare_terms(const PowTerms &terms, const BigInt &mod, Conv conv,
+                  std::vector<BigInt> &bases, std::vector<BigInt> &exps)
+    {
+        for (const auto &[b, e] : terms)
+        {
+            if (e < 0)
+                throw std::invalid_argument("multiModPow exponent should be non-negative...");
+            if (!e)
+                continue;
+            BigInt x = b;
+            if (x < 0 || !(x < mod))
+            {
+                x = x % mod;
+                if (x < 0)
+                    x += mod;
+            }
+            bases.push_back(conv(x));
+            exps.push_back(e);
+        }
+    }
+
+    BigInt multiModPow(const PowTerms &terms, const MontgomeryContext &ctx)
+    {
+        std::vector<BigInt> bases, exps;
+        prepare_terms(terms, ctx.modulus(), [&ctx](const BigInt &x)
+                      { return ctx.toMont(x); }, bases, exps);
+        if (bases.empty())
+            return BigInt(1) % ctx.modulus();
+
+        auto mul = [&ctx](const BigInt &a, const BigInt &b)
+        { return ctx.mul(a, b); };
+        auto sqr = [&ctx](const BigInt &a)
+        { return ctx.sqr(a); };
+        return ctx.fromMont(interleavedPow(bases, exps, mul, sqr));
+    }
+
+    BigInt multiModPow(const PowTerms &terms, const BarrettContext &ctx)
+    {
+        std::vector<BigInt> bases, exps;
+        prepare_terms(terms, ctx.modulus(), [](const BigInt &x)
+                      { return x; }, bases, exps);
+        if (bases.empty())
+            return BigInt(1) % ctx.modulus();
+
+        auto mul = [&ctx](const BigInt &a, const BigInt &b)
+        { return ctx.mul(a, b); };
+        auto sqr = [&ctx](const BigInt &a)
+        { return ctx.sqr(a); };
+        return interleavedPow(bases, exps, mul, sqr);
+    }
+
+    BigInt multiModPow(const PowTerms &terms, const BigInt &mod)
+    {
+        if (!(mod > 0))
+            throw std::invalid_argument("multiModPow modulus should be positive...");
+#if defined(BIT_USE_MONTGOMERY)
+        if (mod.bit(0))
+            return multiModPow(terms, MontgomeryContext(mod));
+#endif
+        return multiModPow(terms, BarrettContext(mod));
+    }
+
     BigInt hash(const BigInt &x)
     {
         return x;
@@ -1,5 +1,8 @@
 #include <rsa/big_integer.h>
+#include <rsa/limb.h>
 #include <bitset>
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <cassert>
 #include <iostream>
@@ -39,22 +42,37 @@ hex2char(int ch)
     return 'A' + ch - 10;
 }
 
+static digits_t dec_parse(const char *str, int len);
+static bool hex_parse_words(const char *str, int len, digits_t &digits);
+
 BigInt::BigInt(const char *str, int len)
 {
     if (len == 0)
     {
         len = strlen(str);
     }
-    if (len < 2)
-        std::__throw_invalid_argument("len < 2");
-    if (str[0] == '-')
+    if (len > 0 && str[0] == '-')
     {
         sign = true;
         ++str;
         --len;
     }
-    if (str[0] != '0' || str[1] != 'x')
-        std::__throw_invalid_argument("fromString only support hex");
+    if (len < 1)
+        std::__throw_invalid_argument("empty number string");
+
+    if (len < 2 || str[0] != '0' || str[1] != 'x')
+    {
+        for (int i = 0; i < len; ++i)
+            if (str[i] < '0' || str[i] > '9')
+                std::__throw_invalid_argument("fromString only support hex (0x) and decimal");
+        digits = dec_parse(str, len);
+        sign = sign && !digits.empty();
+        return;
+    }
+
+    if (hex_parse_words(str + 2, len - 2, digits))
+        return;
+
     int cnt = 0;
     BIT tmp = 0;
     for (int i = len - 1; i > 1; --i)
@@ -74,6 +92,8 @@ BigInt::BigInt(const char *str, int len)
     }
     if (tmp != 0)
         digits.push_back(tmp);
+    while (!digits.empty() && digits.back() == 0)
+        digits.pop_back();
 }
 
 BigInt::BigInt(const std::string &str) : BigInt(str.c_str(), str.length()) {}
@@ -107,6 +127,21 @@ int BigInt::bits() const
     return BITL * digits.size() - clz();
 }
 
+bool BigInt::bit(int i) const
+{
+    int x = i / BITL;
+    if (i < 0 || x >= static_cast<int>(digits.size()))
+        return false;
+    return (digits[x] >> (i % BITL)) & 1;
+}
+
+BIT BigInt::word(int i) const
+{
+    if (i < 0 || i >= static_cast<int>(digits.size()))
+        return 0;
+    return digits[i];
+}
+
 BigInt::operator bool() const
 {
     return digits.size() != 0;
@@ -155,7 +190,7 @@ bool BigInt::operator!=(const BigInt &other) const
 }
 
 static int
-unsign_compare(const std::vector<BIT> &a1, const std::vector<BIT> &a2)
+unsign_compare(const digits_t &a1, const digits_t &a2)
 {
     int n1 = a1.size();
     int n2 = a2.size();
@@ -163,14 +198,7 @@ unsign_compare(const std::vector<BIT> &a1, const std::vector<BIT> &a2)
         return 1;
     if (n1 < n2)
         return -1;
-    for (int i = n1 - 1; i >= 0; --i)
-    {
-        if (a1[i] > a2[i])
-            return 1;
-        if (a1[i] < a2[i])
-            return -1;
-    }
-    return 0;
+    return BNLimb::cmp(a1.data(), a2.data(), n1);
 }
 
 bool BigInt::operator>(const int other) const
@@ -239,132 +267,45 @@ bool BigInt::operator<(const BigInt &other) const
     return (cmp != 0) && ((cmp < 0) != sign);
 }
 
-static std::vector<BIT>
-unsign_add(const std::vector<BIT> &a1, const std::vector<BIT> &a2)
+static digits_t
+unsign_add(const digits_t &a1, const digits_t &a2)
 {
     int n1 = a1.size();
     int n2 = a2.size();
     assert(n1 >= n2);
 
-    std::vector<BIT> res(n1, 0);
-    BITT pre = 0;
-
-    for (int i = 0; i < n2; ++i)
-    {
-        pre = pre + a1[i] + a2[i];
-        res[i] = static_cast<BIT>(pre);
-        pre >>= BITL;
-    }
-
-    for (int i = n2; i < n1; ++i)
-    {
-        pre = pre + a1[i];
-        res[i] = static_cast<BIT>(pre);
-        pre >>= BITL;
-    }
-
-    if (pre)
-        res.push_back(pre);
-    assert((pre >> BITL) == 0);
+    digits_t res(n1, 0);
+    BIT carry = BNLimb::add(res.data(), a1.data(), n1, a2.data(), n2);
+    if (carry)
+        res.push_back(carry);
 
     return res;
 }
 
-static std::vector<BIT>
-unsign_sub(const std::vector<BIT> &a1, const std::vector<BIT> &a2)
+static digits_t
+unsign_sub(const digits_t &a1, const digits_t &a2)
 {
     int n1 = a1.size();
     int n2 = a2.size();
     assert(n1 >= n2);
 
-    std::vector<BIT> res(n1, 0);
-    BITT pre = 0;
-
-    for (int i = 0; i < n2; ++i)
-    {
-        pre += a2[i];
-        if (pre > a1[i])
-        {
-            res[i] = static_cast<BIT>(-pre + BIT_MAX + a1[i]);
-            pre = 1;
-        }
-        else
-        {
-            res[i] = static_cast<BIT>(-pre + a1[i]);
-            pre = 0;
-        }
-    }
-    for (int i = n2; i < n1; ++i)
-    {
-        if (pre > a1[i])
-        {
-            res[i] = static_cast<BIT>(-pre + BIT_MAX + a1[i]);
-            pre = 1;
-        }
-        else
-        {
-            res[i] = static_cast<BIT>(-pre + a1[i]);
-            pre = 0;
-        }
-    }
-
-    assert(pre == 0);
-    while (!res.empty() && res.back() == 0)
-        res.pop_back();
+    digits_t res(n1, 0);
+    BIT borrow = BNLimb::sub(res.data(), a1.data(), n1, a2.data(), n2);
+    assert(borrow == 0);
+    (void)borrow;
+    res.resize(BNLimb::normalize(res.data(), n1));
 
     return res;
 }
 
-static void
-unsign_sub_inplace(std::vector<BIT> &a1, const std::vector<BIT> &a2)
-{
-    int n1 = a1.size();
-    int n2 = a2.size();
-    assert(n1 >= n2);
-
-    BITT pre = 0;
-
-    for (int i = 0; i < n2; ++i)
-    {
-        pre += a2[i];
-        if (pre > a1[i])
-        {
-            a1[i] = static_cast<BIT>(-pre + BIT_MAX + a1[i]);
-            pre = 1;
-        }
-        else
-        {
-            a1[i] = static_cast<BIT>(-pre + a1[i]);
-            pre = 0;
-        }
-    }
-    for (int i = n2; i < n1; ++i)
-    {
-        if (pre > a1[i])
-        {
-            a1[i] = static_cast<BIT>(-pre + BIT_MAX + a1[i]);
-            pre = 1;
-        }
-        else
-        {
-            a1[i] = static_cast<BIT>(-pre + a1[i]);
-            pre = 0;
-        }
-    }
-
-    assert(pre == 0);
-    while (!a1.empty() && a1.back() == 0)
-        a1.pop_back();
-}
-
-static inline std::vector<BIT>
-unsign_add_or_sub(const std::vector<BIT> &a1, const std::vector<BIT> &a2, bool is_sub)
+static inline digits_t
+unsign_add_or_sub(const digits_t &a1, const digits_t &a2, bool is_sub)
 {
     return is_sub ? unsign_sub(a1, a2) : unsign_add(a1, a2);
 }
 
 BigInt
-BigInt::operator+(const BigInt &other) const
+BigInt::operator+(const BigInt &other) const &
 {
     int cmp = unsign_compare(digits, other.digits);
     bool sub = sign != other.sign;
@@ -383,18 +324,15 @@ BigInt::operator+=(const int other)
     if (other < 0 || sign)
         throw std::runtime_error("+= with -number is not implement...");
 
-    BITT pre = other;
-    for (auto &x : digits)
+    if (digits.empty())
     {
-        pre += x;
-        x = static_cast<BIT>(pre);
-        pre >>= BITL;
-        if (pre == 0)
-            return *this;
+        if (other)
+            digits.push_back(static_cast<BIT>(other));
+        return *this;
     }
-    if (pre)
-        digits.push_back(static_cast<BIT>(pre));
-    assert((pre >> BITL) == 0);
+    BIT carry = BNLimb::add_1(digits.data(), digits.data(), digits.size(), static_cast<BIT>(other));
+    if (carry)
+        digits.push_back(carry);
     return *this;
 }
 
@@ -404,27 +342,17 @@ BigInt::operator-(const int other) const
     if (other < 0 || sign)
         throw std::runtime_error("- with -number is not implement...");
 
+    if (digits.empty())
+        return BigInt();
     int n = digits.size();
-    std::vector<BIT> res(digits.size(), 0);
-    BITT pre = other;
-    for (int i = 0; i < n; ++i)
-    {
-        if (pre > digits[i])
-        {
-            res[i] = static_cast<BIT>(-pre + BIT_MAX + digits[i]);
-            pre = 1;
-        }
-        else
-        {
-            res[i] = static_cast<BIT>(-pre + digits[i]);
-            pre = 0;
-        }
-    }
+    digits_t res(n, 0);
+    BNLimb::sub_1(res.data(), digits.data(), n, static_cast<BIT>(other));
+    res.resize(BNLimb::normalize(res.data(), n));
     return BigInt(std::move(res), false);
 }
 
 BigInt
-BigInt::operator-(const BigInt &other) const
+BigInt::operator-(const BigInt &other) const &
 {
     bool sign1 = !other.sign;
     int cmp = unsign_compare(digits, other.digits);
@@ -437,49 +365,67 @@ BigInt::operator-(const BigInt &other) const
         return BigInt(unsign_add_or_sub(other.digits, digits, sub), sign1);
 }
 
-static std::vector<BIT>
-unsign_mul_one(const std::vector<BIT> &a1, BIT a2)
+// a += (sb ? -b : b)，在 a 的存储上原地完成，允许 a 与 b 为同一对象
+static void
+signed_add_inplace(digits_t &a, bool &sa, const digits_t &b, bool sb)
 {
-    if (a2 == 0)
-        return std::vector<BIT>();
-
-    int n1 = a1.size();
-    std::vector<BIT> res(n1, 0);
-
-    BITT pre = 0;
-    for (int i = 0; i < n1; ++i)
+    int na = a.size(), nb = b.size();
+    if (sa == sb)
     {
-        pre += static_cast<BITT>(1) * a1[i] * a2;
-        res[i] = static_cast<BIT>(pre);
-        pre >>= BITL;
+        if (na < nb)
+            a.resize(nb, 0);
+        BIT c = BNLimb::add(a.data(), a.data(), a.size(), b.data(), nb);
+        if (c)
+            a.push_back(c);
+        return;
     }
 
-    if (pre)
-        res.push_back(pre);
-    assert((pre >> BITL) == 0);
-
-    return res;
+    int cmp = unsign_compare(a, b);
+    if (cmp == 0)
+    {
+        a.clear();
+        sa = false;
+        return;
+    }
+    if (cmp > 0)
+        BNLimb::sub(a.data(), a.data(), na, b.data(), nb);
+    else
+    {
+        // a = b - a
+        a.resize(nb, 0);
+        BIT borrow = BNLimb::sub_n(a.data(), b.data(), a.data(), nb);
+        assert(borrow == 0);
+        (void)borrow;
+        sa = sb;
+    }
+    while (!a.empty() && a.back() == 0)
+        a.pop_back();
 }
 
-static void
-unsign_mul_one_inplace(std::vector<BIT> &a1, BIT a2)
+BigInt
+BigInt::operator+(const BigInt &other) &&
 {
-    if (a2 == 0)
-        return a1.clear(), void();
+    return std::move(*this += other);
+}
 
-    int n1 = a1.size();
+BigInt
+BigInt::operator-(const BigInt &other) &&
+{
+    return std::move(*this -= other);
+}
 
-    BITT pre = 0;
-    for (int i = 0; i < n1; ++i)
-    {
-        pre += static_cast<BITT>(1) * a1[i] * a2;
-        a1[i] = static_cast<BIT>(pre);
-        pre >>= BITL;
-    }
+BigInt &
+BigInt::operator+=(const BigInt &other)
+{
+    signed_add_inplace(digits, sign, other.digits, other.sign);
+    return *this;
+}
 
-    if (pre)
-        a1.push_back(pre);
-    assert((pre >> BITL) == 0);
+BigInt &
+BigInt::operator-=(const BigInt &other)
+{
+    signed_add_inplace(digits, sign, other.digits, !other.sign);
+    return *this;
 }
 
 BigInt
@@ -490,100 +436,65 @@ BigInt::operator*(const BigInt &other) const
 
     int n1 = digits.size();
     int n2 = other.digits.size();
-    int n = n1 + n2 - 1;
 
-    std::vector<BITT> tmp(n + 1, 0);
-    for (int i = 0; i < n1; ++i)
-        for (int j = 0; j < n2; ++j)
-        {
-            auto now = static_cast<BITT>(1) * digits[i] * other.digits[j];
-            tmp[i + j + 1] += (now >> BITL);
-            tmp[i + j] += static_cast<BIT>(now);
-        }
-
-    BITT pre = 0;
-    std::vector<BIT> res(n + 1, 0);
-    for (int i = 0; i <= n; ++i)
-    {
-        pre += tmp[i];
-        res[i] = static_cast<BIT>(pre);
-        pre >>= BITL;
-    }
-    assert(pre == 0);
+    digits_t res(n1 + n2, 0);
+    BNLimb::mul(res.data(), digits.data(), n1, other.digits.data(), n2);
     while (res.back() == 0)
         res.pop_back();
 
     return BigInt(std::move(res), sign != other.sign);
 }
 
-static std::pair<std::vector<BIT>, std::vector<BIT>>
-unsign_div_and_mod(const std::vector<BIT> &a1, const std::vector<BIT> &a2)
+BigInt &
+BigInt::operator*=(const BigInt &other)
 {
-    int n1 = a1.size();
-    int n2 = a2.size();
-    assert(n2 != 0 && n1 >= n2);
-    int n = n1 - n2 + 1;
-
-    std::vector<BIT> res(n, 0);
-    std::vector<BIT> rem(n2, 0);
-    for (int i = 0; i < n2; ++i)
-        rem[i] = a1[n + i - 1];
-    assert(rem.back() != 0);
-
-    int nr;
-    BITT x, y = a2.back(), l, r, mid;
-    for (int i = n - 1; i >= 0; --i)
-    {
-        x = 0;
-        nr = rem.size();
-        if (nr > n2)
-        {
-            assert(nr == n2 + 1);
-            x = (static_cast<BITT>(rem[n2]) << BITL) | static_cast<BITT>(rem[n2 - 1]);
-        }
-        else if (nr == n2)
-            x = rem[n2 - 1];
-        else
-            goto div_end;
-
-        r = std::min(x / y + 1, BIT_MAX), l = x / (y + 1);
-        while (l + 1 < r)
-        {
-            mid = (l + r) >> 1;
-            int cmp = unsign_compare(rem, unsign_mul_one(a2, static_cast<BIT>(mid)));
-            if (cmp == 0)
-            {
-                res[i] = static_cast<BIT>(mid);
-                rem.clear();
-                goto div_end;
-            }
-            if (cmp > 0)
-                l = mid;
-            else
-                r = mid;
-        }
-        if (l)
-        {
-            res[i] = static_cast<BIT>(l);
-            unsign_sub_inplace(rem, unsign_mul_one(a2, res[i]));
-            assert(unsign_compare(rem, a2) <= 0);
-        }
+    if (!*this || !other)
+    {
+        digits.clear();
+        sign = false;
+        return *this;
+    }
 
-    div_end:
-        if (i == 0)
-            continue;
+    // 乘法的输出不能与输入重叠，复制左操作数后把乘积直接写回 digits
+    int n1 = digits.size();
+    int n2 = other.digits.size();
+    digits_t a(digits);
+    digits.resize(n1 + n2);
+    if (&other == this)
+        BNLimb::sqr(digits.data(), a.data(), n1);
+    else
+        BNLimb::mul(digits.data(), a.data(), n1, other.digits.data(), n2);
+    while (digits.back() == 0)
+        digits.pop_back();
+    sign = sign != other.sign;
+    return *this;
+}
 
-        nr = rem.size();
-        rem.push_back(0);
-        for (int j = nr; j >= 1; --j)
-            rem[j] = rem[j - 1];
-        rem[0] = a1[i - 1];
-        assert(rem.back() != 0);
-    }
+BigInt
+BigInt::square() const
+{
+    if (!*this)
+        return BigInt(0);
 
-    while (!res.empty() && res.back() == 0)
+    int n = digits.size();
+    digits_t res(2 * n, 0);
+    BNLimb::sqr(res.data(), digits.data(), n);
+    while (res.back() == 0)
         res.pop_back();
 
+    return BigInt(std::move(res), false);
+}
+
+// 返回 a1 / a2 与 a1 % a2，要求 a1 >= a2 > 0
+static std::pair<digits_t, digits_t>
+unsign_div_and_mod(const digits_t &a1, const digits_t &a2)
+{
+    int n1 = a1.size();
+    int n2 = a2.size();
+    digits_t res(n1 - n2 + 1), rem(n2);
+    BNLimb::divrem(res.data(), rem.data(), a1.data(), n1, a2.data(), n2);
+    res.resize(BNLimb::normalize(res.data(), res.size()));
+    rem.resize(BNLimb::normalize(rem.data(), n2));
     return std::make_pair(std::move(res), std::move(rem));
 }
 
@@ -614,18 +525,17 @@ prime_t
 BigInt::operator%(const prime_t other) const
 {
     assert(sign == false);
-    int n = digits.size();
-    BITT pre = 0;
-    for (int i = n - 1; i >= 0; --i)
-    {
-        pre = (pre << BITL) | digits[i];
-        pre %= other;
-    }
-    return static_cast<prime_t>(pre);
+    BNLimb::SmallDivisor d(other);
+    return static_cast<prime_t>(BNLimb::mod_1(digits.data(), digits.size(), d));
+}
+
+void BigInt::residues(const BNLimb::SmallDivisor *ds, int m, BIT *out) const
+{
+    BNLimb::mod_1s(out, digits.data(), digits.size(), ds, m);
 }
 
 BigInt
-BigInt::operator%(const BigInt &other) const
+BigInt::operator%(const BigInt &other) const &
 {
     int n1 = digits.size();
     int n2 = other.digits.size();
@@ -647,6 +557,96 @@ BigInt::operator%(const BigInt &other) const
     return BigInt(std::move(rem), flag);
 }
 
+BigInt
+BigInt::operator%(const BigInt &other) &&
+{
+    return std::move(*this %= other);
+}
+
+BigInt &
+BigInt::operator%=(const BigInt &other)
+{
+    int n1 = digits.size();
+    int n2 = other.digits.size();
+    if (n2 == 0)
+        throw std::runtime_error("div zero occured...");
+
+    bool flag = sign != other.sign;
+
+    int cmp = unsign_compare(digits, other.digits);
+    if (cmp < 0)
+    {
+        sign = flag && n1 != 0;
+        return *this;
+    }
+    if (cmp == 0)
+    {
+        digits.clear();
+        sign = false;
+        return *this;
+    }
+
+    // 余数直接在 digits 中原地计算，只多占用一个字
+    digits.push_back(0);
+    BNLimb::mod(digits.data(), n1, other.digits.data(), n2);
+    digits.resize(BNLimb::normalize(digits.data(), n2));
+    sign = flag && !digits.empty();
+    return *this;
+}
+
+BigInt
+BigInt::mulAddMod(const BigInt &b, const BigInt &c, const BigInt &m) const
+{
+    int na = digits.size(), nb = b.digits.size(), nc = c.digits.size();
+    int nm = m.digits.size();
+    if (nm == 0 || m.sign)
+        throw std::runtime_error("modulus should be positive...");
+
+    // t[0, len) 依次存放 |ab|、ab + c，多留的两个字分别给加法进位和 BNLimb::mod
+    // 最后取 m - r 时结果写满 nm 个字，存储也不能少于 nm 个字
+    int np = na && nb ? na + nb : 0;
+    int len = std::max(np, nc);
+    digits_t t(std::max(len + 2, nm), 0);
+    if (np)
+        BNLimb::mul(t.data(), digits.data(), na, b.digits.data(), nb);
+    bool neg = np && sign != b.sign;
+
+    if (nc)
+    {
+        if (np == 0 || neg == c.sign)
+        {
+            t[len] = BNLimb::add(t.data(), t.data(), len, c.digits.data(), nc);
+            neg = c.sign;
+        }
+        else
+        {
+            int nt = BNLimb::normalize(t.data(), len);
+            if (nt > nc || (nt == nc && BNLimb::cmp(t.data(), c.digits.data(), nc) >= 0))
+                BNLimb::sub(t.data(), t.data(), nt, c.digits.data(), nc);
+            else
+            {
+                BNLimb::sub(t.data(), c.digits.data(), nc, t.data(), nt);
+                neg = c.sign;
+            }
+        }
+    }
+
+    int nt = BNLimb::normalize(t.data(), len + 1);
+    if (nt > nm || (nt == nm && BNLimb::cmp(t.data(), m.digits.data(), nm) >= 0))
+    {
+        BNLimb::mod(t.data(), nt, m.digits.data(), nm);
+        nt = BNLimb::normalize(t.data(), nm);
+    }
+    // 负数的余数再取 m - r
+    if (neg && nt)
+    {
+        BNLimb::sub(t.data(), m.digits.data(), nm, t.data(), nt);
+        nt = BNLimb::normalize(t.data(), nm);
+    }
+    t.resize(nt);
+    return BigInt(std::move(t), false);
+}
+
 std::pair<BigInt, BigInt>
 BigInt::divAndMod(const BigInt &other) const
 {
@@ -673,7 +673,7 @@ BigInt::divAndMod(const BigInt &other) const
 BigInt
 BigInt::operator|(const unsigned int other) const
 {
-    std::vector<BIT> res = digits;
+    digits_t res = digits;
     if (res.empty())
         res.push_back(other);
     else
@@ -690,7 +690,7 @@ void BigInt::operator|=(const unsigned int other)
 }
 
 BigInt
-BigInt::operator>>(const int bits) const
+BigInt::operator>>(const int bits) const &
 {
     if (bits < 0)
         throw std::runtime_error("rshift bits less than 0...");
@@ -702,7 +702,7 @@ BigInt::operator>>(const int bits) const
     const int x = bits / BITL;
     const int y = bits % BITL;
     const int n = digits.size();
-    std::vector<BIT> res(n - x, 0);
+    digits_t res(n - x, 0);
 
     if (y == 0)
     {
@@ -754,69 +754,421 @@ BigInt::operator>>=(const int bits)
     return *this;
 }
 
-BigInt BigInt::operator<<(const int bits) const
+BigInt
+BigInt::operator>>(const int bits) &&
+{
+    return std::move(*this >>= bits);
+}
+
+BigInt
+BigInt::operator<<(const int bits) const &
 {
-    throw std::runtime_error("not implement function...");
-    return BigInt(bits);
+    return BigInt(*this) <<= bits;
 }
 
 BigInt
-BigInt::modPowBasic(const BigInt &exp, const BigInt &mod) const
+BigInt::operator<<(const int bits) &&
+{
+    return std::move(*this <<= bits);
+}
+
+BigInt &
+BigInt::operator<<=(const int bits)
+{
+    if (bits < 0)
+        throw std::runtime_error("lshift bits less than 0...");
+    if (bits == 0 || digits.empty())
+        return *this;
+
+    const int x = bits / BITL;
+    const int y = bits % BITL;
+    const int n = digits.size();
+    digits.resize(n + x + 1, 0);
+
+    if (y == 0)
+    {
+        for (int i = n - 1; i >= 0; --i)
+            digits[i + x] = digits[i];
+    }
+    else
+    {
+        digits[n + x] = digits[n - 1] >> (BITL - y);
+        for (int i = n - 1; i > 0; --i)
+            digits[i + x] = (digits[i] << y) | (digits[i - 1] >> (BITL - y));
+        digits[x] = digits[0] << y;
+    }
+    std::fill(digits.begin(), digits.begin() + x, 0);
+
+    if (digits.back() == 0)
+        digits.pop_back();
+    return *this;
+}
+
+// 十六进制字符的值，非十六进制字符为 -1
+static const signed char *
+hex_table()
+{
+    static signed char table[256];
+    static bool init = [] {
+        std::fill(table, table + 256, -1);
+        for (int i = 0; i < 16; ++i)
+            table[static_cast<unsigned char>(hex2char(i))] = i;
+        for (int i = 10; i < 16; ++i)
+            table['a' + i - 10] = i;
+        return true;
+    }();
+    (void)init;
+    return table;
+}
+
+// 8 个十六进制字符转为 32 位整数，str[0] 为最高位
+static inline unsigned long long
+hex8_value(const char *str)
+{
+    unsigned long long c;
+    memcpy(&c, str, 8);
+    c = __builtin_bswap64(c);
+    // '0'-'9' 低 4 位即为数值，字母的第 6 位为 1，值为低 4 位加 9
+    c = (c & 0x0F0F0F0F0F0F0F0Full) + 9 * ((c >> 6) & 0x0101010101010101ull);
+    c = (c | (c >> 4)) & 0x00FF00FF00FF00FFull;
+    c = (c | (c >> 8)) & 0x0000FFFF0000FFFFull;
+    return (c | (c >> 16)) & 0xFFFFFFFFull;
+}
+
+// 不含分隔符的十六进制串每 8 个字符一次转换，含分隔符时返回 false 交给逐字符解析
+static bool
+hex_parse_words(const char *str, int len, digits_t &digits)
+{
+#if defined(BIT_USE_64) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const signed char *table = hex_table();
+    for (int i = 0; i < len; ++i)
+        if (table[static_cast<unsigned char>(str[i])] < 0)
+            return false;
+
+    digits.resize((len + 15) / 16, 0);
+    int i = len, k = 0;
+    for (; i >= 16; i -= 16, ++k)
+        digits[k] = (hex8_value(str + i - 16) << 32) | hex8_value(str + i - 8);
+    BIT tmp = 0;
+    for (int j = 0; j < i; ++j)
+        tmp = (tmp << 4) | table[static_cast<unsigned char>(str[j])];
+    if (i > 0)
+        digits[k] = tmp;
+    while (!digits.empty() && digits.back() == 0)
+        digits.pop_back();
+    return true;
+#else
+    (void)str, (void)len, (void)digits;
+    return false;
+#endif
+}
+
+// 十进制转换时每个字保存 DEC_CHUNK 位十进制数，DEC_BASE = 10^DEC_CHUNK < B
+#if defined(BIT_USE_64)
+#define DEC_CHUNK 19
+#define DEC_BASE 10000000000000000000ull
+#else
+#define DEC_CHUNK 9
+#define DEC_BASE 1000000000u
+#endif
+
+// pw[k] = DEC_BASE^(2^k)，按需延长
+static const digits_t &
+dec_power(std::vector<digits_t> &pw, int k)
+{
+    if (pw.empty())
+        pw.push_back(digits_t(1, DEC_BASE));
+    while (static_cast<int>(pw.size()) <= k)
+    {
+        const digits_t &x = pw.back();
+        digits_t y(2 * x.size(), 0);
+        BNLimb::sqr(y.data(), x.data(), x.size());
+        y.resize(BNLimb::normalize(y.data(), y.size()));
+        pw.push_back(std::move(y));
+    }
+    return pw[k];
+}
+
+// 解析 len 位十进制数字，较短时逐块乘加，否则按 10^(DEC_CHUNK * 2^k) 拆为高低两半分别解析
+static digits_t
+dec_parse(const char *str, int len, std::vector<digits_t> &pw)
 {
-    BigInt x = *this;
-    BigInt res = BigInt(1);
-    BIT tmp;
-    int n = exp.digits.size();
-    for (int i = 0; i < n - 1; ++i)
+    if (len <= DEC_CHUNK * BIT_DEC_DC_THRESHOLD)
     {
-        BIT tmp = exp.digits[i];
-        for (int j = 0; j < BITL; ++j)
+        digits_t res;
+        int first = (len - 1) % DEC_CHUNK + 1;
+        for (int i = 0; i < len;)
         {
-            if (tmp & 1)
-                res = res * x % mod;
-            x = x * x % mod;
-            tmp >>= 1;
+            int n = i == 0 ? first : DEC_CHUNK;
+            BIT v = 0;
+            for (int j = 0; j < n; ++j)
+                v = v * 10 + (str[i + j] - '0');
+            i += n;
+
+            BIT c = BNLimb::mul_1(res.data(), res.data(), res.size(), DEC_BASE);
+            if (c)
+                res.push_back(c);
+            c = BNLimb::add_1(res.data(), res.data(), res.size(), v);
+            if (c)
+                res.push_back(c);
         }
+        return res;
     }
-    tmp = exp.digits.back();
-    while (true)
+
+    int k = 0;
+    while (DEC_CHUNK * (2 << k) < len)
+        ++k;
+    int low = DEC_CHUNK << k;
+    digits_t hi = dec_parse(str, len - low, pw);
+    digits_t lo = dec_parse(str + len - low, low, pw);
+    if (hi.empty())
+        return lo;
+
+    const digits_t &p = dec_power(pw, k);
+    digits_t res(hi.size() + p.size() + 1, 0);
+    BNLimb::mul(res.data(), hi.data(), hi.size(), p.data(), p.size());
+    BNLimb::add(res.data(), res.data(), res.size(), lo.data(), lo.size());
+    res.resize(BNLimb::normalize(res.data(), res.size()));
+    return res;
+}
+
+static digits_t
+dec_parse(const char *str, int len)
+{
+    std::vector<digits_t> pw;
+    return dec_parse(str, len, pw);
+}
+
+static digits_t
+unsign_mul(const digits_t &a, const digits_t &b)
+{
+    if (a.empty() || b.empty())
+        return digits_t();
+    digits_t res(a.size() + b.size(), 0);
+    BNLimb::mul(res.data(), a.data(), a.size(), b.data(), b.size());
+    res.resize(BNLimb::normalize(res.data(), res.size()));
+    return res;
+}
+
+// 返回 floor(B^2k / p)，k 为 p 的字数，较短时直接做除法
+// 否则由 p 的高 h 个字 (加一，保证不超过真实值) 递归求出约 h 字精度的近似 x，再做一次 Newton 迭代
+// x1 = x + x * (B^2k - p * x) / B^2k 精度翻倍，整个过程只需 O(M(k))，最后至多修正几次
+static digits_t
+dec_reciprocal(const digits_t &p)
+{
+    int k = p.size();
+    if (k <= BIT_KARATSUBA_THRESHOLD)
     {
-        if (tmp & 1)
-            res = res * x % mod;
-        tmp >>= 1;
-        if (tmp == 0)
-            break;
-        x = x * x % mod;
+        digits_t b(2 * k + 1, 0);
+        b.back() = 1;
+        return unsign_div_and_mod(b, p).first;
+    }
+
+    int h = (k + 1) / 2 + 2, l = k - h;
+    digits_t ph(p.data() + l, p.data() + k), x;
+    if (BNLimb::add_1(ph.data(), ph.data(), h, 1))
+    {
+        x.resize(h + 1, 0);
+        x.back() = 1;
+    }
+    else
+        x = dec_reciprocal(ph);
+
+    // 以 B^l 为单位：t = p * x <= B^(k+h)，e = B^(k+h) - t，x1 = x * B^l + floor(x * e / B^2h)
+    digits_t e(k + h + 1, 0);
+    e.back() = 1;
+    digits_t t = unsign_mul(p, x);
+    e = unsign_sub(e, t);
+    digits_t y = unsign_mul(x, e);
+    digits_t res(l + x.size(), 0);
+    std::copy(x.begin(), x.end(), res.begin() + l);
+    if (static_cast<int>(y.size()) > 2 * h)
+    {
+        digits_t d(y.data() + 2 * h, y.data() + y.size());
+        res = unsign_add(res, d);
+    }
+
+    // res 不超过真实值，余数 B^2k - p * res 不小于 p 时逐次加一
+    digits_t r(2 * k + 1, 0);
+    r.back() = 1;
+    r = unsign_sub(r, unsign_mul(p, res));
+    while (unsign_compare(r, p) >= 0)
+    {
+        r = unsign_sub(r, p);
+        res.push_back(0);
+        BNLimb::add_1(res.data(), res.data(), res.size(), 1);
+        res.resize(BNLimb::normalize(res.data(), res.size()));
     }
     return res;
 }
 
+// mu[k] = floor(B^(2|pw[k]|) / pw[k])，按需计算
+static const digits_t &
+dec_power_inv(std::vector<digits_t> &pw, std::vector<digits_t> &mu, int k)
+{
+    while (static_cast<int>(mu.size()) <= k)
+        mu.push_back(dec_reciprocal(dec_power(pw, mu.size())));
+    return mu[k];
+}
+
+// 将 x 的十进制表示追加到 out，pad 不为 0 时左侧补零到恰好 pad 位
+// 较长时除以 p = pw[k] (|p| >= |x| / 2) 拆为高低两半，除法借助预先求出的倒数 mu 只需两次乘法
+static void
+dec_print(const digits_t &x, int pad, std::vector<digits_t> &pw, std::vector<digits_t> &mu, std::string &out)
+{
+    int n = x.size();
+    if (n <= BIT_DEC_DC_THRESHOLD)
+    {
+        static const BNLimb::SmallDivisor dec_base(DEC_BASE);
+        digits_t q = x;
+        std::string s;
+        while (!q.empty())
+        {
+            BIT r = BNLimb::divrem_1(q.data(), q.data(), q.size(), dec_base);
+            q.resize(BNLimb::normalize(q.data(), q.size()));
+            for (int j = 0; j < DEC_CHUNK && (r || !q.empty()); ++j, r /= 10)
+                s += static_cast<char>('0' + r % 10);
+        }
+        if (pad > static_cast<int>(s.size()))
+            out.append(pad - s.size(), '0');
+        else if (s.empty())
+            s = "0";
+        out.append(s.rbegin(), s.rend());
+        return;
+    }
+
+    // 取最小的 k 使 x < B^(2|p|)
+    int k = 0;
+    while (2 * static_cast<int>(dec_power(pw, k).size()) < n)
+        ++k;
+    const digits_t &p = dec_power(pw, k);
+    const digits_t &m = dec_power_inv(pw, mu, k);
+    int low = DEC_CHUNK << k;
+    int np = p.size();
+
+    // q = floor(x * mu / B^2|p|) 至多比真实的商小 2
+    digits_t q, r = x;
+    digits_t y = unsign_mul(x, m);
+    if (static_cast<int>(y.size()) > 2 * np)
+    {
+        q = digits_t(y.data() + 2 * np, y.data() + y.size());
+        r = unsign_sub(r, unsign_mul(q, p));
+    }
+    while (unsign_compare(r, p) >= 0)
+    {
+        r = unsign_sub(r, p);
+        q.push_back(0);
+        BNLimb::add_1(q.data(), q.data(), q.size(), 1);
+        q.resize(BNLimb::normalize(q.data(), q.size()));
+    }
+
+    if (q.empty())
+        return dec_print(r, pad, pw, mu, out);
+    dec_print(q, pad ? pad - low : 0, pw, mu, out);
+    dec_print(r, low, pw, mu, out);
+}
+
 std::string
-BigInt::toString() const
+BigInt::toString(int base) const
 {
     int n = digits.size();
+    if (base == 10)
+    {
+        std::string res = sign ? "-" : "";
+        std::vector<digits_t> pw, mu;
+        dec_print(digits, 0, pw, mu, res);
+        return res;
+    }
+    if (base != 16)
+        throw std::invalid_argument("toString only support base 10 and 16");
+
     if (n == 0)
         return "0x0";
 
-    std::string res = sign ? "-0x" : "0x";
-    for (int j = 4; j <= BITL; j += 4)
-    {
-        BIT now = digits.back() >> (BITL - j);
-        if (now == 0)
-            continue;
-        res += hex2char(now & 0xF);
-    }
+    int top = (BITL - clz() % BITL + 3) / 4;
+    std::string res(sign + 2 + top + (n - 1) * (BITL / 4), '0');
+    char *p = &res[0];
+    if (sign)
+        *p++ = '-';
+    p[1] = 'x';
+    p += 2;
 
+    for (int j = top - 1; j >= 0; --j)
+        *p++ = hex2char((digits.back() >> (4 * j)) & 0xF);
     for (int i = n - 2; i >= 0; --i)
-        for (int j = 4; j <= BITL; j += 4)
-            res += hex2char((digits[i] >> (BITL - j)) & 0xF);
+    {
+        BIT x = digits[i];
+        for (int j = BITL / 4 - 1; j >= 0; --j, x >>= 4)
+            p[j] = hex2char(x & 0xF);
+        p += BITL / 4;
+    }
 
     return res;
 }
 
+// 按大端字节序读写一个字
+static inline BIT
+load_be(const uint8_t *src)
+{
+    BIT w;
+    memcpy(&w, src, sizeof(BIT));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    w = BIT_BSWAP(w);
+#endif
+    return w;
+}
+
+static inline void
+store_be(uint8_t *dst, BIT w)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    w = BIT_BSWAP(w);
+#endif
+    memcpy(dst, &w, sizeof(BIT));
+}
+
+BigInt
+BigInt::fromBytes(const uint8_t *src, size_t len)
+{
+    const size_t w = sizeof(BIT);
+    digits_t res((len + w - 1) / w, 0);
+    size_t i = len;
+    int k = 0;
+    for (; i >= w; i -= w, ++k)
+        res[k] = load_be(src + i - w);
+
+    BIT top = 0;
+    for (size_t j = 0; j < i; ++j)
+        top = (top << 8) | src[j];
+    if (i > 0)
+        res[k] = top;
+
+    res.resize(BNLimb::normalize(res.data(), res.size()));
+    return BigInt(std::move(res), false);
+}
+
+void BigInt::toBytes(uint8_t *dst, size_t len) const
+{
+    if (sign)
+        throw std::runtime_error("toBytes with negative number...");
+    const size_t w = sizeof(BIT);
+    if (static_cast<size_t>(bits()) > len * 8)
+        throw std::runtime_error("toBytes buffer too small...");
+
+    size_t i = len;
+    int k = 0, n = digits.size();
+    for (; i >= w && k < n; i -= w, ++k)
+        store_be(dst + i - w, digits[k]);
+
+    BIT top = k < n ? digits[k] : 0;
+    for (; i > 0 && top; --i, top >>= 8)
+        dst[i - 1] = static_cast<uint8_t>(top);
+    memset(dst, 0, i);
+}
+
 void BigInt::debug() const
 {
-    fprintf(stderr, "%d %zu\n", sign, digits.size());
+    fprintf(stderr, "%d %d\n", sign, digits.size());
     for (auto x : digits)
         BigInt::debug(x, ' ');
     fprintf(stderr, "\n");
@@ -0,0 +1,166 @@
+#include <rsa/big_integer.h>
+
+#if defined(BIT_USE_AVX2)
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstring>
+
+// 降基数表示：每个数位 28 位，两数位之积不超过 56 位
+// 64 位累加器可容纳 2^8 个乘积之和，故较短操作数的数位数不能超过 255
+#define AVX2_DIGIT_BITS 28
+#define AVX2_DIGIT_MASK ((1ull << AVX2_DIGIT_BITS) - 1)
+#define AVX2_MAX_DIGITS ((2 * BIT_AVX2_MAX_LIMBS * 64 + AVX2_DIGIT_BITS - 1) / AVX2_DIGIT_BITS)
+
+static_assert(BIT_AVX2_MAX_LIMBS * 64 / AVX2_DIGIT_BITS < 255, "AVX2 accumulator may overflow");
+
+// 将 n 个字拆成 28 位数位，返回数位个数
+static int
+avx2_split(const BIT *a, int n, unsigned long long *d)
+{
+    int m = (n * 64 + AVX2_DIGIT_BITS - 1) / AVX2_DIGIT_BITS;
+    for (int i = 0; i < m; ++i)
+    {
+        int bit = i * AVX2_DIGIT_BITS, w = bit / 64, o = bit % 64;
+        unsigned long long v = a[w] >> o;
+        if (o > 64 - AVX2_DIGIT_BITS && w + 1 < n)
+            v |= a[w + 1] << (64 - o);
+        d[i] = v & AVX2_DIGIT_MASK;
+    }
+    return m;
+}
+
+// 按列分块的乘积累加：每轮计算 16 列，结果留在 4 个 ymm 寄存器中
+// b 的数位两侧各填充 16 个零，使得越界的列读到 0
+__attribute__((target("avx2"))) static void
+avx2_mul_columns(const unsigned long long *a, int da, const unsigned long long *b, int db,
+                 unsigned long long *acc)
+{
+    int dn = da + db;
+    for (int c0 = 0; c0 < dn; c0 += 16)
+    {
+        __m256i s0 = _mm256_setzero_si256(), s1 = s0, s2 = s0, s3 = s0;
+        int lo = std::max(0, c0 - db + 1), hi = std::min(da - 1, c0 + 15);
+        for (int i = lo; i <= hi; ++i)
+        {
+            __m256i ai = _mm256_set1_epi64x(a[i]);
+            const unsigned long long *p = b + c0 - i;
+            s0 = _mm256_add_epi64(s0, _mm256_mul_epu32(ai, _mm256_loadu_si256((const __m256i *)p)));
+            s1 = _mm256_add_epi64(s1, _mm256_mul_epu32(ai, _mm256_loadu_si256((const __m256i *)(p + 4))));
+            s2 = _mm256_add_epi64(s2, _mm256_mul_epu32(ai, _mm256_loadu_si256((const __m256i *)(p + 8))));
+            s3 = _mm256_add_epi64(s3, _mm256_mul_epu32(ai, _mm256_loadu_si256((const __m256i *)(p + 12))));
+        }
+        _mm256_storeu_si256((__m256i *)(acc + c0), s0);
+        _mm256_storeu_si256((__m256i *)(acc + c0 + 4), s1);
+        _mm256_storeu_si256((__m256i *)(acc + c0 + 8), s2);
+        _mm256_storeu_si256((__m256i *)(acc + c0 + 12), s3);
+    }
+}
+
+bool
+bit_cpu_has_avx2()
+{
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+// res[0, na + nb) = a * b，要求 nb <= na <= 2 * BIT_AVX2_MAX_LIMBS 且 nb <= BIT_AVX2_MAX_LIMBS
+void
+unsign_mul_avx2(const BIT *a, int na, const BIT *b, int nb, BIT *res)
+{
+    alignas(32) unsigned long long da[AVX2_MAX_DIGITS + 16];
+    alignas(32) unsigned long long db[AVX2_MAX_DIGITS + 48];
+    alignas(32) unsigned long long acc[2 * AVX2_MAX_DIGITS + 16];
+
+    int ma = avx2_split(a, na, da);
+    unsigned long long *pb = db + 16;
+    std::fill(db, pb, 0);
+    int mb = avx2_split(b, nb, pb);
+    std::fill(pb + mb, pb + mb + 32, 0);
+
+    avx2_mul_columns(da, ma, pb, mb, acc);
+
+    // 进位传播并拼回 64 位字
+    int n = na + nb;
+    std::fill(res, res + n, 0);
+    unsigned long long carry = 0;
+    for (int k = 0; k < ma + mb; ++k)
+    {
+        unsigned long long v = acc[k] + carry;
+        carry = v >> AVX2_DIGIT_BITS;
+        v &= AVX2_DIGIT_MASK;
+        int bit = k * AVX2_DIGIT_BITS, w = bit / 64, o = bit % 64;
+        if (w < n)
+            res[w] |= v << o;
+        if (o > 64 - AVX2_DIGIT_BITS && w + 1 < n)
+            res[w + 1] |= v >> (64 - o);
+    }
+}
+
+// dt[0, n) += m * dn[0, n)，n 为 4 的倍数，dt 不要求对齐
+__attribute__((target("avx2"))) static void
+avx2_addmul_digits(unsigned long long *dt, const unsigned long long *dn, int n, unsigned long long m)
+{
+    __m256i vm = _mm256_set1_epi64x(m);
+    for (int j = 0; j < n; j += 4)
+    {
+        __m256i t = _mm256_loadu_si256((const __m256i *)(dt + j));
+        __m256i p = _mm256_mul_epu32(vm, _mm256_load_si256((const __m256i *)(dn + j)));
+        _mm256_storeu_si256((__m256i *)(dt + j), _mm256_add_epi64(t, p));
+    }
+}
+
+// r[0, k + 1) = t * B^{-k} mod N (结果小于 2N)，ninv = -N^{-1} mod B，要求 t < B^k * N 且 k <= BIT_AVX2_MAX_LIMBS
+// 在 28 位数位上逐位约减，共 64k / 28 个整数位再加一个只取低 64k % 28 位的部分位，使 R 仍为 B^k
+// 每列至多累加 64k / 28 + 1 个 56 位乘积，进位在每步之后传给下一位，r 可以与 t 相同
+void
+redc_avx2(BIT *r, const BIT *t, int nt, const BIT *n, int k, BIT ninv)
+{
+    alignas(32) unsigned long long dt[AVX2_MAX_DIGITS + 32];
+    alignas(32) unsigned long long dn[AVX2_MAX_DIGITS / 2 + 16];
+
+    int mn = avx2_split(n, k, dn);
+    int pn = (mn + 3) & ~3;
+    std::fill(dn + mn, dn + pn, 0);
+
+    int steps = k * 64 / AVX2_DIGIT_BITS, rest = k * 64 % AVX2_DIGIT_BITS;
+    int mt = avx2_split(t, nt, dt);
+    int total = steps + 1 + pn;
+    std::fill(dt + mt, dt + total + 1, 0);
+
+    unsigned long long n0 = ninv & AVX2_DIGIT_MASK;
+    for (int i = 0; i < steps; ++i)
+    {
+        unsigned long long m = (dt[i] * n0) & AVX2_DIGIT_MASK;
+        avx2_addmul_digits(dt + i, dn, pn, m);
+        dt[i + 1] += dt[i] >> AVX2_DIGIT_BITS;
+    }
+    if (rest)
+    {
+        unsigned long long m = (dt[steps] * n0) & ((1ull << rest) - 1);
+        avx2_addmul_digits(dt + steps, dn, pn, m);
+    }
+
+    // 从第 64k 位开始进位传播并拼回 64 位字
+    std::fill(r, r + k + 1, 0);
+    unsigned long long carry = 0;
+    for (int j = steps; j <= total; ++j)
+    {
+        unsigned long long v = dt[j] + carry;
+        carry = v >> AVX2_DIGIT_BITS;
+        v &= AVX2_DIGIT_MASK;
+        int bit = (j - steps) * AVX2_DIGIT_BITS - rest;
+        if (bit < 0)
+        {
+            r[0] |= v >> rest;
+            continue;
+        }
+        int w = bit / 64, o = bit % 64;
+        if (w <= k)
+            r[w] |= v << o;
+        if (o > 64 - AVX2_DIGIT_BITS && w + 1 <= k)
+            r[w + 1] |= v >> (64 - o);
+    }
+}
+
+#endif
@@ -1,50 +1,248 @@
 #include <rsa/big_integer.h>
+#include <rsa/modpow.h>
+#include <rsa/limb.h>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 
-static BigInt
-modBarrett(const BigInt &x, const BigInt &mod, const BigInt inv, int k)
+BigInt
+BigInt::modPowBasic(const BigInt &exp, const BigInt &mod) const
+{
+    if (!exp)
+        return BigInt(1) % mod;
+
+    auto mul = [&mod](const BigInt &a, const BigInt &b)
+    { return a * b % mod; };
+    auto sqr = [&mod](const BigInt &a)
+    { return a.square() % mod; };
+    return slideWindowPow(*this % mod, exp, mul, sqr);
+}
+
+BarrettContext::BarrettContext(const BigInt &mod) : mod(mod)
+{
+    if (!(mod > 0))
+        throw std::runtime_error("barrett modulus should be positive...");
+
+    k = mod.digits.size();
+    digits_t b(2 * k + 1, 0);
+    b.back() = 1;
+    mu = BigInt(std::move(b), false) / mod;
+}
+
+BigInt
+BarrettContext::reduce(const BigInt &x) const
 {
-    BigInt res = x - ((x * inv) >> (2 * k * BITL)) * mod;
-    if (res > mod)
-        return res - mod;
+    // q = floor(floor(x / B^(k-1)) * mu / B^(k+1))，与真实商至多相差 2
+    BigInt q = ((x >> ((k - 1) * BITL)) * mu) >> ((k + 1) * BITL);
+
+    // x - qN < 3N < B^(k+1)，只需在低 k + 1 个字上相减，qN 也只求低 k + 1 个字
+    int n = k + 1;
+    digits_t r(n, 0), t(n);
+    std::copy(x.digits.begin(), x.digits.begin() + std::min<int>(n, x.digits.size()), r.begin());
+    BNLimb::mul_lo(t.data(), q.digits.data(), q.digits.size(), mod.digits.data(), k, n);
+    BNLimb::sub_n(r.data(), r.data(), t.data(), n);
+    r.resize(BNLimb::normalize(r.data(), n));
+
+    BigInt res(std::move(r), false);
+    while (!(res < mod))
+        res -= mod;
     return res;
 }
 
+BigInt
+BarrettContext::mul(const BigInt &a, const BigInt &b) const
+{
+    return reduce(a * b);
+}
+
+BigInt
+BarrettContext::sqr(const BigInt &a) const
+{
+    return reduce(a.square());
+}
+
+BigInt
+BigInt::modMul(const BigInt &other, const BarrettContext &ctx) const
+{
+    return ctx.mul(*this, other);
+}
+
 BigInt
 BigInt::modPowBarrett(const BigInt &exp, const BigInt &mod) const
 {
-    int k = std::max(digits.size(), mod.digits.size()) + 1;
-    std::vector<BIT> mu(2 * k + 1, 0);
-    mu.back() = 1;
-    BigInt inv = BigInt(std::move(mu), false) / mod;
-
-    BigInt x = *this;
-    BigInt res = BigInt(1);
-    BIT tmp;
-    BigInt tmpb;
-    int n = exp.digits.size();
-    for (int i = 0; i < n - 1; ++i)
+    return modPow(exp, BarrettContext(mod));
+}
+
+BigInt
+BigInt::modPow(const BigInt &exp, const BarrettContext &ctx) const
+{
+    const BigInt &mod = ctx.modulus();
+    if (!exp)
+        return BigInt(1) % mod;
+
+    auto mul = [&ctx](const BigInt &a, const BigInt &b)
+    { return ctx.mul(a, b); };
+    auto sqr = [&ctx](const BigInt &a)
+    { return ctx.sqr(a); };
+
+    if (sign || !(*this < mod))
     {
-        BIT tmp = exp.digits[i];
-        for (int j = 0; j < BITL; ++j)
+        BigInt x = *this % mod;
+        if (x < 0)
+            x += mod;
+        return slideWindowPow(x, exp, mul, sqr);
+    }
+    return slideWindowPow(*this, exp, mul, sqr);
+}
+
+// Newton 迭代求 -N^{-1} mod B，每轮正确位数翻倍
+static BIT
+mont_ninv(BIT n0)
+{
+    assert(n0 & 1);
+    BIT x = n0;
+    for (int i = 0; i < 6; ++i)
+        x *= 2 - n0 * x;
+    return -x;
+}
+
+MontgomeryContext::MontgomeryContext(const BigInt &mod) : mod(mod)
+{
+    if (!mod || mod.sign || !(mod.digits.front() & 1))
+        throw std::runtime_error("montgomery modulus should be positive odd...");
+
+    k = mod.digits.size();
+    ninv = mont_ninv(mod.digits.front());
+
+    digits_t r(2 * k + 1, 0);
+    r.back() = 1;
+    r2 = BigInt(std::move(r), false) % mod;
+}
+
+BigInt
+MontgomeryContext::redc(BigInt &&x) const
+{
+    digits_t &t = x.digits;
+    const digits_t &n = mod.digits;
+    assert(static_cast<int>(t.size()) <= 2 * k);
+
+#if defined(BIT_USE_AVX2)
+    if (k >= BIT_AVX2_THRESHOLD && k <= BIT_AVX2_MAX_LIMBS && bit_cpu_has_avx2())
+    {
+        // 结果写满 k + 1 个字，输入较短时先扩展存储，不能在写入后再 resize 清零高位
+        int nt = t.size();
+        if (nt < k + 1)
+            t.resize(k + 1, 0);
+        redc_avx2(t.data(), t.data(), nt, n.data(), k, ninv);
+        t.resize(k + 1);
+    }
+    else
+#endif
+    {
+        t.resize(2 * k + 1, 0);
+        for (int i = 0; i < k; ++i)
         {
-            if (tmp & 1)
-                res = modBarrett(res * x, mod, inv, k);
-            x = modBarrett(x * x, mod, inv, k);
-            tmp >>= 1;
+            BIT m = t[i] * ninv;
+            BIT carry = BNLimb::addmul_1(t.data() + i, n.data(), k, m);
+            BNLimb::add_1(t.data() + i + k, t.data() + i + k, k + 1 - i, carry);
         }
+        t.erase(t.begin(), t.begin() + k);
     }
-    tmp = exp.digits.back();
-    while (true)
+    while (!t.empty() && t.back() == 0)
+        t.pop_back();
+    x.sign = false;
+
+    if (x < mod)
+        return std::move(x);
+    return x - mod;
+}
+
+BigInt
+MontgomeryContext::mul(const BigInt &a, const BigInt &b) const
+{
+    return redc(a * b);
+}
+
+BigInt
+MontgomeryContext::sqr(const BigInt &a) const
+{
+    return redc(a.square());
+}
+
+// 高位补零到 k 个字
+static digits_t
+mont_pad(const digits_t &a, int k)
+{
+    digits_t r(k, 0);
+    std::copy(a.begin(), a.end(), r.begin());
+    return r;
+}
+
+BigInt
+MontgomeryContext::mulCios(const BigInt &a, const BigInt &b) const
+{
+    digits_t r = mont_pad(a.digits, k);
+    if (&a == &b)
+        BNLimb::mont_sqr(r.data(), r.data(), mod.digits.data(), k, ninv);
+    else
+        BNLimb::mont_mul(r.data(), r.data(), mont_pad(b.digits, k).data(), mod.digits.data(), k, ninv);
+    r.resize(BNLimb::normalize(r.data(), k));
+    return BigInt(std::move(r), false);
+}
+
+BigInt
+MontgomeryContext::sqrCios(const BigInt &a) const
+{
+    return mulCios(a, a);
+}
+
+BigInt
+MontgomeryContext::toMont(const BigInt &x) const
+{
+    if (x.sign || !(x < mod))
     {
-        if (tmp & 1)
-            res = modBarrett(res * x, mod, inv, k);
-        tmp >>= 1;
-        if (tmp == 0)
-            break;
-        x = modBarrett(x * x, mod, inv, k);
+        BigInt y = x % mod;
+        if (y < 0)
+            y = y + mod;
+        return mul(y, r2);
     }
-    return res;
-}
\ No newline at end of file
+    return mul(x, r2);
+}
+
+BigInt
+MontgomeryContext::fromMont(const BigInt &x) const
+{
+    return redc(BigInt(x));
+}
+
+BigInt
+BigInt::modPowCios(const BigInt &exp, const MontgomeryContext &ctx) const
+{
+    if (!exp)
+        return BigInt(1) % ctx.modulus();
+
+    auto mul = [&ctx](const BigInt &a, const BigInt &b)
+    { return ctx.mulCios(a, b); };
+    auto sqr = [&ctx](const BigInt &a)
+    { return ctx.sqrCios(a); };
+    return ctx.fromMont(slideWindowPow(ctx.toMont(*this), exp, mul, sqr));
+}
+
+BigInt
+BigInt::modPowMontgomery(const BigInt &exp, const BigInt &mod) const
+{
+    return modPowMontgomery(exp, MontgomeryContext(mod));
+}
+
+BigInt
+BigInt::modPowMontgomery(const BigInt &exp, const MontgomeryContext &ctx) const
+{
+    if (!exp)
+        return BigInt(1) % ctx.modulus();
+
+    auto mul = [&ctx](const BigInt &a, const BigInt &b)
+    { return ctx.mul(a, b); };
+    auto sqr = [&ctx](const BigInt &a)
+    { return ctx.sqr(a); };
+    return ctx.fromMont(slideWindowPow(ctx.toMont(*this), exp, mul, sqr));
+}
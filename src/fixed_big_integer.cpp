@@ -0,0 +1,36 @@
+#include <rsa/fixed_big_integer.h>
+
+BigInt
+modPowFixed(const BigInt &x, const BigInt &exp, const MontgomeryContext &ctx)
+{
+    const BigInt &mod = ctx.modulus();
+    if (x < 0 || !(x < mod))
+    {
+        BigInt y = x % mod;
+        if (y < 0)
+            y = y + mod;
+        return modPowFixed(y, exp, ctx);
+    }
+
+    switch (ctx.size())
+    {
+    case 1024 / BITL:
+        return FixedMontgomery<1024 / BITL>(ctx).modPow(x, exp);
+    case 2048 / BITL:
+        return FixedMontgomery<2048 / BITL>(ctx).modPow(x, exp);
+    case 3072 / BITL:
+        return FixedMontgomery<3072 / BITL>(ctx).modPow(x, exp);
+    case 4096 / BITL:
+        return FixedMontgomery<4096 / BITL>(ctx).modPow(x, exp);
+    default:
+        return x.modPowMontgomery(exp, ctx);
+    }
+}
+
+BigInt
+modPowFixed(const BigInt &x, const BigInt &exp, const BigInt &mod)
+{
+    if (!(mod > 1) || (mod % 2) == 0)
+        return x.modPow(exp, mod);
+    return modPowFixed(x, exp, MontgomeryContext(mod));
+}
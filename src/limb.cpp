@@ -0,0 +1,815 @@
+#include <rsa/limb.h>
+#include <rsa/limb_ops.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#if defined(BIT_USE_THREADS)
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#endif
+
+namespace BNLimb
+{
+    int cmp(const BIT *a, const BIT *b, int n)
+    {
+        for (int i = n - 1; i >= 0; --i)
+        {
+            if (a[i] > b[i])
+                return 1;
+            if (a[i] < b[i])
+                return -1;
+        }
+        return 0;
+    }
+
+    int normalize(const BIT *a, int n)
+    {
+        while (n > 0 && a[n - 1] == 0)
+            --n;
+        return n;
+    }
+
+    BIT add_n(BIT *r, const BIT *a, const BIT *b, int n)
+    {
+        BIT carry = 0;
+        for (int i = 0; i < n; ++i)
+            carry = limb_addc(a[i], b[i], carry, &r[i]);
+        return carry;
+    }
+
+    BIT add(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        assert(na >= nb);
+        BIT carry = add_n(r, a, b, nb);
+        return add_1(r + nb, a + nb, na - nb, carry);
+    }
+
+    BIT add_1(BIT *r, const BIT *a, int n, BIT b)
+    {
+        int i = 0;
+        for (; b && i < n; ++i)
+            b = limb_addc(a[i], b, 0, &r[i]);
+        if (r != a)
+            std::copy(a + i, a + n, r + i);
+        return b;
+    }
+
+    BIT sub_n(BIT *r, const BIT *a, const BIT *b, int n)
+    {
+        BIT borrow = 0;
+        for (int i = 0; i < n; ++i)
+            borrow = limb_subb(a[i], b[i], borrow, &r[i]);
+        return borrow;
+    }
+
+    BIT sub(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        assert(na >= nb);
+        BIT borrow = sub_n(r, a, b, nb);
+        return sub_1(r + nb, a + nb, na - nb, borrow);
+    }
+
+    BIT sub_1(BIT *r, const BIT *a, int n, BIT b)
+    {
+        int i = 0;
+        for (; b && i < n; ++i)
+            b = limb_subb(a[i], b, 0, &r[i]);
+        if (r != a)
+            std::copy(a + i, a + n, r + i);
+        return b;
+    }
+
+    BIT mul_1(BIT *r, const BIT *a, int n, BIT b)
+    {
+        return limb_mul_row(r, a, n, b);
+    }
+
+    BIT addmul_1(BIT *r, const BIT *a, int n, BIT b)
+    {
+        return limb_addmul_row(r, a, n, b);
+    }
+
+    BIT submul_1(BIT *r, const BIT *a, int n, BIT b)
+    {
+        return limb_submul_row(r, a, n, b);
+    }
+
+    BIT lshift(BIT *r, const BIT *a, int n, int s)
+    {
+        assert(0 < s && s < BITL);
+        BIT out = a[n - 1] >> (BITL - s);
+        for (int i = n - 1; i > 0; --i)
+            r[i] = (a[i] << s) | (a[i - 1] >> (BITL - s));
+        r[0] = a[0] << s;
+        return out;
+    }
+
+    BIT rshift(BIT *r, const BIT *a, int n, int s)
+    {
+        assert(0 < s && s < BITL);
+        BIT out = a[0] << (BITL - s);
+        for (int i = 0; i < n - 1; ++i)
+            r[i] = (a[i] >> s) | (a[i + 1] << (BITL - s));
+        r[n - 1] = a[n - 1] >> s;
+        return out;
+    }
+
+    void mul_basecase(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        std::fill(r, r + na, 0);
+        for (int j = 0; j < nb; ++j)
+            r[j + na] = addmul_1(r + j, a, na, b[j]);
+    }
+
+    // 小规模时逐行乘加并截掉 B^n 以上的部分，约为完整乘积一半的乘法次数
+    // 规模较大时截断的逐行乘法不如 Karatsuba，直接求完整乘积再取低位
+    void mul_lo(BIT *r, const BIT *a, int na, const BIT *b, int nb, int n)
+    {
+        na = std::min(na, n), nb = std::min(nb, n);
+        if (na == 0 || nb == 0)
+        {
+            std::fill(r, r + n, 0);
+            return;
+        }
+        if (std::min(na, nb) >= 2 * BIT_KARATSUBA_THRESHOLD)
+        {
+            digits_t t(na + nb);
+            mul(t.data(), a, na, b, nb);
+            std::copy(t.begin(), t.begin() + std::min(n, na + nb), r);
+            std::fill(r + std::min(n, na + nb), r + n, 0);
+            return;
+        }
+
+        std::fill(r, r + n, 0);
+        for (int j = 0; j < nb; ++j)
+        {
+            int len = std::min(na, n - j);
+            BIT carry = addmul_1(r + j, a, len, b[j]);
+            if (j + len < n)
+                r[j + len] = carry;
+        }
+    }
+
+    // 交叉项 a[i] * a[j] (i < j) 只计算一次后整体左移一位，再加上对角项
+    void sqr_basecase(BIT *r, const BIT *a, int n)
+    {
+        std::fill(r, r + 2 * n, 0);
+        for (int i = 0; i < n; ++i)
+            r[i + n] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+
+        BIT top = lshift(r, r, 2 * n, 1);
+        assert(top == 0);
+        (void)top;
+
+        BIT carry = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            BIT hi;
+            BIT lo = limb_mul(a[i], a[i], &hi);
+            carry = limb_addc(r[2 * i], lo, carry, &r[2 * i]);
+            carry = limb_addc(r[2 * i + 1], hi, carry, &r[2 * i + 1]);
+        }
+        assert(carry == 0);
+    }
+
+    // r[0, nr) += a[0, na)，返回最高位进位
+    static BIT
+    add_to(BIT *r, int nr, const BIT *a, int na)
+    {
+        return add(r, r, nr, a, na);
+    }
+
+    // r[0, nr) -= a[0, na)，返回最高位借位
+    static BIT
+    sub_from(BIT *r, int nr, const BIT *a, int na)
+    {
+        return sub(r, r, nr, a, na);
+    }
+
+#if defined(BIT_USE_THREADS)
+    static std::atomic<int> parallel_threads{0};
+    // 除最初的调用者外正在运行的子任务线程数，不超过可用线程数减一
+    static std::atomic<int> parallel_busy{0};
+    // 当前线程所处的并行拆分层数，每个子任务 (包括在调用者线程上执行的) 都在父任务的层数加一上运行
+    static thread_local int parallel_depth = 0;
+
+    void set_threads(int n)
+    {
+        parallel_threads = n;
+    }
+
+    // 规模与层数允许拆分时，从剩余的线程预算中预留至多 want 个线程，返回实际预留的个数
+    static int
+    reserve_threads(int n, int want)
+    {
+        if (n < BIT_PARALLEL_THRESHOLD || parallel_depth >= BIT_PARALLEL_DEPTH)
+            return 0;
+        int limit = parallel_threads;
+        if (limit == 0)
+            limit = std::thread::hardware_concurrency();
+
+        int busy = parallel_busy, got;
+        do
+        {
+            got = std::min(want, limit - 1 - busy);
+            if (got <= 0)
+                return 0;
+        } while (!parallel_busy.compare_exchange_weak(busy, busy + got));
+        return got;
+    }
+
+    // 在作用域内把本线程的拆分层数设为 depth，离开时恢复
+    struct ParallelDepthScope
+    {
+        int prev;
+        explicit ParallelDepthScope(int depth) : prev(parallel_depth) { parallel_depth = depth; }
+        ~ParallelDepthScope() { parallel_depth = prev; }
+    };
+
+    // 新线程的 small_vector_resource() 为默认资源，子任务内部的临时数值不经过调用者的 arena
+    // 调用者必须预先分配好子任务写入的存储，子任务不能对调用者线程创建的容器扩容或赋值
+    static std::future<void>
+    fork(const std::function<void()> &f, int depth)
+    {
+        return std::async(std::launch::async, [depth, &f]()
+                          {
+                              struct Release
+                              {
+                                  ~Release() { --parallel_busy; }
+                              } release;
+                              ParallelDepthScope scope(depth);
+                              f(); });
+    }
+#endif
+
+    // 执行若干写入互不重叠的子乘法，n 足够大且线程预算有剩余时把靠后的若干个放到新线程中
+    template <typename F, typename... Rest>
+    static void
+    run_tasks(int n, F &&first, Rest &&...rest)
+    {
+#if defined(BIT_USE_THREADS)
+        constexpr int cnt = 1 + sizeof...(Rest);
+        int depth = parallel_depth;
+        int forked = reserve_threads(n, cnt - 1);
+        if (forked > 0)
+        {
+            const std::function<void()> tasks[cnt] = {first, rest...};
+            std::future<void> futures[cnt];
+            for (int i = cnt - forked; i < cnt; ++i)
+                futures[i] = fork(tasks[i], depth + 1);
+            {
+                ParallelDepthScope scope(depth + 1);
+                for (int i = 0; i < cnt - forked; ++i)
+                    tasks[i]();
+            }
+            for (int i = cnt - forked; i < cnt; ++i)
+                futures[i].get();
+            return;
+        }
+        ParallelDepthScope scope(depth + 1);
+#else
+        (void)n;
+#endif
+        first();
+        (rest(), ...);
+    }
+
+    // Karatsuba 乘法，要求 na >= nb > na / 2 且 na >= 4
+    // a = a1 * B^m + a0, b = b1 * B^m + b0
+    // ab = z2 * B^2m + ((a0 + a1)(b0 + b1) - z0 - z2) * B^m + z0
+    static void
+    mul_karatsuba(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        int m = na / 2;
+        int na1 = na - m, nb1 = nb - m;
+        assert(nb1 > 0);
+
+        digits_t sa(na1 + 1, 0), sb(std::max(m, nb1) + 1, 0);
+        sa[na1] = add(sa.data(), a + m, na1, a, m);
+        if (nb1 >= m)
+            sb[nb1] = add(sb.data(), b + m, nb1, b, m);
+        else
+            sb[m] = add(sb.data(), b, m, b + m, nb1);
+
+        int nsa = sa.size(), nsb = sb.size();
+        nsa -= sa.back() == 0, nsb -= sb.back() == 0;
+        int ns = nsa + nsb;
+        digits_t z1(ns, 0);
+        run_tasks(
+            nb, [&]
+            { mul(z1.data(), sa.data(), nsa, sb.data(), nsb); },
+            [&]
+            { mul(r, a, m, b, m); },
+            [&]
+            { mul(r + 2 * m, a + m, na1, b + m, nb1); });
+
+        sub_from(z1.data(), ns, r, 2 * m);
+        sub_from(z1.data(), ns, r + 2 * m, na1 + nb1);
+        ns = normalize(z1.data(), ns);
+        add_to(r + m, na + nb - m, z1.data(), ns);
+    }
+
+    // Karatsuba 平方，a^2 = z2 * B^2m + ((a0 + a1)^2 - z0 - z2) * B^m + z0
+    static void
+    sqr_karatsuba(BIT *r, const BIT *a, int n)
+    {
+        int m = n / 2;
+        int n1 = n - m;
+
+        digits_t sa(n1 + 1, 0);
+        sa[n1] = add(sa.data(), a + m, n1, a, m);
+
+        int nsa = sa.size() - (sa.back() == 0);
+        int ns = 2 * nsa;
+        digits_t z1(ns, 0);
+        run_tasks(
+            n, [&]
+            { sqr(z1.data(), sa.data(), nsa); },
+            [&]
+            { sqr(r, a, m); },
+            [&]
+            { sqr(r + 2 * m, a + m, n1); });
+
+        sub_from(z1.data(), ns, r, 2 * m);
+        sub_from(z1.data(), ns, r + 2 * m, 2 * n1);
+        ns = normalize(z1.data(), ns);
+        add_to(r + m, 2 * n - m, z1.data(), ns);
+    }
+
+    // 带符号的字数组，Toom-3 求值与插值时使用，d 不含高位零字
+    struct SignedLimbs
+    {
+        digits_t d;
+        bool sign = false;
+    };
+
+    static digits_t
+    limbs_trim(const BIT *a, int n)
+    {
+        return digits_t(a, a + normalize(a, n));
+    }
+
+    static int
+    limbs_compare(const digits_t &a, const digits_t &b)
+    {
+        if (a.size() != b.size())
+            return a.size() > b.size() ? 1 : -1;
+        return cmp(a.data(), b.data(), a.size());
+    }
+
+    // 要求 a >= b
+    static digits_t
+    limbs_add(const digits_t &a, const digits_t &b)
+    {
+        digits_t res(a.size(), 0);
+        BIT carry = add(res.data(), a.data(), a.size(), b.data(), b.size());
+        if (carry)
+            res.push_back(carry);
+        return res;
+    }
+
+    // 要求 a > b
+    static digits_t
+    limbs_sub(const digits_t &a, const digits_t &b)
+    {
+        digits_t res(a.size(), 0);
+        sub(res.data(), a.data(), a.size(), b.data(), b.size());
+        res.resize(normalize(res.data(), res.size()));
+        return res;
+    }
+
+    // 返回 a + b 或 a - b
+    static SignedLimbs
+    signed_add(const SignedLimbs &a, const SignedLimbs &b, bool neg = false)
+    {
+        bool sign = b.sign != neg;
+        int c = limbs_compare(a.d, b.d);
+        if (a.sign == sign)
+        {
+            if (c >= 0)
+                return {limbs_add(a.d, b.d), sign};
+            return {limbs_add(b.d, a.d), sign};
+        }
+        if (c == 0)
+            return {};
+        if (c > 0)
+            return {limbs_sub(a.d, b.d), a.sign};
+        return {limbs_sub(b.d, a.d), sign};
+    }
+
+    // r[0, |a| + |b|) = |a * b|，a 与 b 为同一对象时做平方，不申请存储
+    static void
+    signed_mul_into(BIT *r, const SignedLimbs &a, const SignedLimbs &b)
+    {
+        int na = a.d.size(), nb = b.d.size();
+        if (na == 0 || nb == 0)
+            std::fill(r, r + na + nb, 0);
+        else if (&a == &b)
+            sqr(r, a.d.data(), na);
+        else
+            mul(r, a.d.data(), na, b.d.data(), nb);
+    }
+
+    static void
+    limbs_lshift1(digits_t &a)
+    {
+        if (a.empty())
+            return;
+        BIT top = lshift(a.data(), a.data(), a.size(), 1);
+        if (top)
+            a.push_back(top);
+    }
+
+    static void
+    limbs_rshift1(digits_t &a)
+    {
+        if (a.empty())
+            return;
+        rshift(a.data(), a.data(), a.size(), 1);
+        if (a.back() == 0)
+            a.pop_back();
+    }
+
+    // 精确除以 3，利用 3 在模 B 下的逆元避免除法
+    static void
+    limbs_divexact_by3(digits_t &a)
+    {
+        const BIT third = static_cast<BIT>(-1) / 3;
+        const BIT inv3 = 2 * third + 1;
+        BIT c = 0;
+        for (auto &x : a)
+        {
+            BIT l = x - c;
+            c = l > x;
+            x = l * inv3;
+            c += (x > third) + (x > 2 * third);
+        }
+        assert(c == 0);
+        a.resize(normalize(a.data(), a.size()));
+    }
+
+    // 将 a 按 m 字拆为三段，返回在 0, 1, -1, -2, inf 处的取值
+    static std::array<SignedLimbs, 5>
+    toom3_eval(const BIT *a, int na, int m)
+    {
+        SignedLimbs a0{limbs_trim(a, m)}, a1{limbs_trim(a + m, m)}, a2{limbs_trim(a + 2 * m, na - 2 * m)};
+        SignedLimbs p = signed_add(a0, a2);
+        SignedLimbs p1 = signed_add(p, a1);
+        SignedLimbs pm1 = signed_add(p, a1, true);
+        SignedLimbs pm2 = signed_add(pm1, a2);
+        limbs_lshift1(pm2.d);
+        pm2 = signed_add(pm2, a0, true);
+        return {std::move(a0), std::move(p1), std::move(pm1), std::move(pm2), std::move(a2)};
+    }
+
+    // Toom-3 乘法，要求 na >= nb > 2 * ceil(na / 3)，a 与 b 相同时只需求值一次
+    // 在 0, 1, -1, -2, inf 五点求值，插值序列参考 Bodrato
+    static void
+    mul_toom3(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        int m = (na + 2) / 3;
+        assert(nb > 2 * m);
+
+        auto pa = toom3_eval(a, na, m);
+        std::array<SignedLimbs, 5> pbv;
+        const auto &pb = (a == b && na == nb) ? pa : (pbv = toom3_eval(b, nb, m));
+
+        // 五个乘积写入调用者预先分配的同一块存储的不同区间
+        // 子任务只在这块存储上读写，不会在调用者的内存资源上申请或释放
+        std::array<int, 6> off{};
+        for (int i = 0; i < 5; ++i)
+            off[i + 1] = off[i] + pa[i].d.size() + pb[i].d.size();
+        digits_t prod(off[5]);
+        auto task = [&](int i)
+        { signed_mul_into(prod.data() + off[i], pa[i], pb[i]); };
+        run_tasks(
+            nb, [&]
+            { task(0); },
+            [&]
+            { task(1); },
+            [&]
+            { task(2); },
+            [&]
+            { task(3); },
+            [&]
+            { task(4); });
+
+        std::array<SignedLimbs, 5> rs;
+        for (int i = 0; i < 5; ++i)
+        {
+            rs[i].d = limbs_trim(prod.data() + off[i], off[i + 1] - off[i]);
+            rs[i].sign = !rs[i].d.empty() && pa[i].sign != pb[i].sign;
+        }
+        SignedLimbs &r0 = rs[0], &r1 = rs[1], &rm1 = rs[2], &rm2 = rs[3], &rinf = rs[4];
+
+        SignedLimbs r3 = signed_add(rm2, r1, true);
+        limbs_divexact_by3(r3.d);
+        r1 = signed_add(r1, rm1, true);
+        limbs_rshift1(r1.d);
+        SignedLimbs r2 = signed_add(rm1, r0, true);
+        r3 = signed_add(r2, r3, true);
+        limbs_rshift1(r3.d);
+        SignedLimbs rinf2 = rinf;
+        limbs_lshift1(rinf2.d);
+        r3 = signed_add(r3, rinf2);
+        r2 = signed_add(signed_add(r2, r1), rinf, true);
+        r1 = signed_add(r1, r3, true);
+        assert(!r1.sign && !r2.sign && !r3.sign);
+
+        int n = na + nb;
+        std::fill(r, r + n, 0);
+        std::copy(r0.d.begin(), r0.d.end(), r);
+        std::copy(rinf.d.begin(), rinf.d.end(), r + 4 * m);
+        add_to(r + m, n - m, r1.d.data(), r1.d.size());
+        add_to(r + 2 * m, n - 2 * m, r2.d.data(), r2.d.size());
+        add_to(r + 3 * m, n - 3 * m, r3.d.data(), r3.d.size());
+    }
+
+    void sqr(BIT *r, const BIT *a, int n)
+    {
+        if (n < BIT_KARATSUBA_THRESHOLD)
+            return sqr_basecase(r, a, n);
+#if defined(BIT_USE_64)
+        if (n >= BIT_NTT_THRESHOLD)
+            return mul_ntt(r, a, n, a, n);
+#endif
+        if (n >= BIT_TOOM3_THRESHOLD && n > 2 * ((n + 2) / 3))
+            return mul_toom3(r, a, n, a, n);
+        sqr_karatsuba(r, a, n);
+    }
+
+    void mul(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        if (a == b && na == nb)
+            return sqr(r, a, na);
+
+        if (na < nb)
+            std::swap(a, b), std::swap(na, nb);
+
+        if (nb == 0)
+        {
+            std::fill(r, r + na, 0);
+            return;
+        }
+
+        if (nb < BIT_KARATSUBA_THRESHOLD)
+            return mul_basecase(r, a, na, b, nb);
+
+#if defined(BIT_USE_64)
+        if (nb >= BIT_NTT_THRESHOLD)
+            return mul_ntt(r, a, na, b, nb);
+#endif
+        if (nb >= BIT_TOOM3_THRESHOLD && nb > 2 * ((na + 2) / 3))
+            return mul_toom3(r, a, na, b, nb);
+
+#if defined(BIT_USE_AVX2)
+        if (nb >= BIT_AVX2_THRESHOLD && nb <= BIT_AVX2_MAX_LIMBS && 2 * nb > na && bit_cpu_has_avx2())
+            return unsign_mul_avx2(a, na, b, nb, r);
+#endif
+
+        if (2 * nb > na)
+            return mul_karatsuba(r, a, na, b, nb);
+
+        // 规模相差过大时按 nb 分块
+        std::fill(r, r + na + nb, 0);
+        digits_t tmp(2 * nb);
+        for (int i = 0; i < na; i += nb)
+        {
+            int len = std::min(nb, na - i);
+            mul(tmp.data(), a + i, len, b, nb);
+            add_to(r + i, na + nb - i, tmp.data(), len + nb);
+        }
+    }
+
+    SmallDivisor::SmallDivisor(BIT d) : d(d)
+    {
+        assert(d != 0);
+        s = BIT_CLZ(d);
+        dn = d << s;
+        v = static_cast<BIT>(((static_cast<BITT>(~dn) << BITL) | ~static_cast<BIT>(0)) / dn);
+    }
+
+    BIT divrem_1(BIT *q, const BIT *a, int n, BIT b)
+    {
+        if (n == 1)
+        {
+            BIT x = a[0];
+            q[0] = x / b;
+            return x % b;
+        }
+        return divrem_1(q, a, n, SmallDivisor(b));
+    }
+
+    // 被除数整体左移 s 位后逐字做 2/1 除法，最高的 s 位作为初始余数
+    BIT divrem_1(BIT *q, const BIT *a, int n, const SmallDivisor &d)
+    {
+        if (n == 0)
+            return 0;
+        BIT r = d.shifted(0, a[n - 1]);
+        for (int i = n - 1; i >= 0; --i)
+        {
+            BIT u0 = d.shifted(a[i], i > 0 ? a[i - 1] : 0);
+            q[i] = d.divrem_norm(r, u0, r);
+        }
+        return r >> d.s;
+    }
+
+    BIT mod_1(const BIT *a, int n, const SmallDivisor &d)
+    {
+        if (n == 0)
+            return 0;
+        BIT r = d.shifted(0, a[n - 1]);
+        for (int i = n - 1; i >= 0; --i)
+            d.divrem_norm(r, d.shifted(a[i], i > 0 ? a[i - 1] : 0), r);
+        return r >> d.s;
+    }
+
+    void mod_1s(BIT *out, const BIT *a, int n, const SmallDivisor *ds, int m)
+    {
+        for (int j = 0; j < m; ++j)
+            out[j] = n ? ds[j].shifted(0, a[n - 1]) : 0;
+        for (int i = n - 1; i >= 0; --i)
+        {
+            BIT hi = a[i], lo = i > 0 ? a[i - 1] : 0;
+            for (int j = 0; j < m; ++j)
+                ds[j].divrem_norm(out[j], ds[j].shifted(hi, lo), out[j]);
+        }
+        for (int j = 0; j < m; ++j)
+            out[j] >>= ds[j].s;
+    }
+
+    // Knuth Algorithm D，除数规格化后用最高两字估计商，至多修正两次
+    // Knuth 算法 D 的主循环，u[0, na + 1) 与 v[0, nb) 均已规格化 (v 最高位为 1)
+    // 循环结束后 u[0, nb) 为规格化的余数，q 为空时不保存商
+    static void
+    divrem_norm(BIT *q, BIT *u, int na, const BIT *v, int nb)
+    {
+        const BIT vh = v[nb - 1], vl = v[nb - 2];
+        for (int j = na - nb; j >= 0; --j)
+        {
+            BITT x = (static_cast<BITT>(u[j + nb]) << BITL) | u[j + nb - 1];
+            BITT qhat = x / vh, rhat = x % vh;
+            while (qhat >= BIT_MAX || qhat * vl > ((rhat << BITL) | u[j + nb - 2]))
+            {
+                --qhat;
+                rhat += vh;
+                if (rhat >= BIT_MAX)
+                    break;
+            }
+
+            BIT qj = static_cast<BIT>(qhat);
+            BIT borrow = submul_1(u + j, v, nb, qj);
+            BIT top = u[j + nb];
+            u[j + nb] = top - borrow;
+            if (top < borrow)
+            {
+                // 估计值偏大 1，加回一次除数
+                --qj;
+                u[j + nb] += add_n(u + j, u + j, v, nb);
+            }
+            if (q)
+                q[j] = qj;
+        }
+    }
+
+    void divrem(BIT *q, BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        assert(nb >= 1 && na >= nb && b[nb - 1] != 0);
+
+        if (nb == 1)
+        {
+            r[0] = divrem_1(q, a, na, b[0]);
+            return;
+        }
+
+        // 规格化，使除数最高位为 1
+        int s = BIT_CLZ(b[nb - 1]);
+        digits_t v(nb), u(na + 1);
+        if (s == 0)
+        {
+            std::copy(b, b + nb, v.begin());
+            std::copy(a, a + na, u.begin());
+            u[na] = 0;
+        }
+        else
+        {
+            lshift(v.data(), b, nb, s);
+            u[na] = lshift(u.data(), a, na, s);
+        }
+
+        divrem_norm(q, u.data(), na, v.data(), nb);
+
+        // 余数反规格化
+        if (s == 0)
+            std::copy(u.begin(), u.begin() + nb, r);
+        else
+            rshift(r, u.data(), nb, s);
+    }
+
+    void mod(BIT *a, int na, const BIT *b, int nb)
+    {
+        assert(nb >= 1 && na >= nb && b[nb - 1] != 0);
+
+        if (nb == 1)
+        {
+            a[0] = divrem_1(a, a, na, b[0]);
+            return;
+        }
+
+        // 被除数原地规格化，只有除数需要临时空间
+        int s = BIT_CLZ(b[nb - 1]);
+        if (s == 0)
+        {
+            a[na] = 0;
+            divrem_norm(nullptr, a, na, b, nb);
+            return;
+        }
+
+        digits_t v(nb);
+        lshift(v.data(), b, nb, s);
+        a[na] = lshift(a, a, na, s);
+        divrem_norm(nullptr, a, na, v.data(), nb);
+        rshift(a, a, nb, s);
+    }
+
+    // 一轮约减：t += m * n 使最低字为零后整体右移一个字，t 为 k + 2 个字
+    static inline void
+    mont_reduce_step(BIT *t, const BIT *n, int k, BIT ninv)
+    {
+        BIT m = t[0] * ninv;
+        BITT pre = static_cast<BITT>(m) * n[0] + t[0];
+        pre >>= BITL;
+        for (int j = 1; j < k; ++j)
+        {
+            pre += static_cast<BITT>(m) * n[j] + t[j];
+            t[j - 1] = static_cast<BIT>(pre);
+            pre >>= BITL;
+        }
+        pre += t[k];
+        t[k - 1] = static_cast<BIT>(pre);
+        t[k] = t[k + 1] + static_cast<BIT>(pre >> BITL);
+        t[k + 1] = 0;
+    }
+
+    // t[0, k] < 2n，减去 n 一次后写入 r
+    static inline void
+    mont_final(BIT *r, BIT *t, const BIT *n, int k)
+    {
+        if (t[k] || cmp(t, n, k) >= 0)
+            sub_n(t, t, n, k);
+        std::copy(t, t + k, r);
+    }
+
+    // 第 i 轮先累加 a * b[i]，再约减掉最低字，两步交替进行
+    void mont_mul(BIT *r, const BIT *a, const BIT *b, const BIT *n, int k, BIT ninv)
+    {
+        digits_t t(k + 2, 0);
+        for (int i = 0; i < k; ++i)
+        {
+            BITT pre = 0;
+            for (int j = 0; j < k; ++j)
+            {
+                pre += static_cast<BITT>(a[j]) * b[i] + t[j];
+                t[j] = static_cast<BIT>(pre);
+                pre >>= BITL;
+            }
+            pre += t[k];
+            t[k] = static_cast<BIT>(pre);
+            t[k + 1] = static_cast<BIT>(pre >> BITL);
+            mont_reduce_step(t.data(), n, k, ninv);
+        }
+        mont_final(r, t.data(), n, k);
+    }
+
+    // 第 i 轮累加 a[i]^2 B^i 与 a[i] * 2a[j] B^j (j > i)，交叉项只乘一次
+    // 2a 的各字由相邻两字拼出，a[i] 本身移出的最高位属于对角项，在 j = i + 1 处去掉
+    // 累加值不超过 2a + n < 3B^k，仍在 k + 2 个字内
+    void mont_sqr(BIT *r, const BIT *a, const BIT *n, int k, BIT ninv)
+    {
+        digits_t t(k + 2, 0);
+        for (int i = 0; i < k; ++i)
+        {
+            BITT pre = static_cast<BITT>(a[i]) * a[i] + t[i];
+            t[i] = static_cast<BIT>(pre);
+            pre >>= BITL;
+            for (int j = i + 1; j < k; ++j)
+            {
+                BIT d = a[j] << 1;
+                if (j > i + 1)
+                    d |= a[j - 1] >> (BITL - 1);
+                pre += static_cast<BITT>(a[i]) * d + t[j];
+                t[j] = static_cast<BIT>(pre);
+                pre >>= BITL;
+            }
+            BIT d = i + 1 < k ? a[k - 1] >> (BITL - 1) : 0;
+            pre += static_cast<BITT>(a[i]) * d + t[k];
+            t[k] = static_cast<BIT>(pre);
+            t[k + 1] += static_cast<BIT>(pre >> BITL);
+            mont_reduce_step(t.data(), n, k, ninv);
+        }
+        mont_final(r, t.data(), n, k);
+    }
+}
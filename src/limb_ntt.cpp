@@ -0,0 +1,222 @@
+#include <rsa/limb.h>
+
+#if defined(BIT_USE_64)
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// 三个形如 c * 2^k + 1 的 62 位以内的质数，变换长度至多 2^55
+// 卷积的每一项小于 n * B^2 < p0 * p1 * p2 (约 2^183.7)，经 CRT 还原后是精确值
+#define NTT_PRIMES 3
+#define NTT_MAX_LOG 55
+
+typedef unsigned long long u64;
+typedef __uint128_t u128;
+
+namespace
+{
+    struct NttPrime
+    {
+        u64 p;
+        u64 g;    // 原根
+        u64 pinv; // p^{-1} mod 2^64
+        u64 r2;   // 2^128 mod p
+
+        NttPrime(u64 p, u64 g) : p(p), g(g)
+        {
+            pinv = p;
+            for (int i = 0; i < 6; ++i)
+                pinv *= 2 - p * pinv;
+            u128 r = (static_cast<u128>(1) << 64) % p;
+            r2 = static_cast<u64>(r * r % p);
+        }
+
+        // Montgomery 乘法，a, b < p 时返回 ab 2^{-64} mod p，结果在 [0, p) 内
+        u64 mul(u64 a, u64 b) const
+        {
+            u128 t = static_cast<u128>(a) * b;
+            u64 m = static_cast<u64>(t) * pinv;
+            u64 th = static_cast<u64>(t >> 64), mh = static_cast<u64>((static_cast<u128>(m) * p) >> 64);
+            u64 r = th - mh;
+            return th < mh ? r + p : r;
+        }
+        u64 add(u64 a, u64 b) const
+        {
+            u64 r = a + b;
+            return r >= p ? r - p : r;
+        }
+        u64 sub(u64 a, u64 b) const
+        {
+            return a >= b ? a - b : a + p - b;
+        }
+
+        u64 toMont(u64 a) const { return mul(a % p, r2); }
+        u64 fromMont(u64 a) const { return mul(a, 1); }
+
+        // 普通形式下的 a^e mod p
+        u64 pow(u64 a, u64 e) const
+        {
+            u64 x = toMont(a), r = toMont(1);
+            for (; e; e >>= 1, x = mul(x, x))
+                if (e & 1)
+                    r = mul(r, x);
+            return fromMont(r);
+        }
+
+        // tw[h + j] = w_{2h}^j (Montgomery 形式)，h 取 1, 2, 4, ..., n / 2
+        void roots(std::vector<u64> &tw, int n, bool inverse) const
+        {
+            tw.assign(n, 0);
+            for (int h = 1; h < n; h <<= 1)
+            {
+                u64 w = pow(g, (p - 1) / (2 * h));
+                if (inverse)
+                    w = pow(w, p - 2);
+                w = toMont(w);
+                u64 x = toMont(1);
+                for (int j = 0; j < h; ++j, x = mul(x, w))
+                    tw[h + j] = x;
+            }
+        }
+
+        // 自然顺序输入，位逆序输出 (DIF)
+        void forward(u64 *a, int n, const std::vector<u64> &tw) const
+        {
+            for (int h = n >> 1; h >= 1; h >>= 1)
+                for (int s = 0; s < n; s += 2 * h)
+                    for (int j = 0; j < h; ++j)
+                    {
+                        u64 u = a[s + j], v = a[s + j + h];
+                        a[s + j] = add(u, v);
+                        a[s + j + h] = mul(sub(u, v), tw[h + j]);
+                    }
+        }
+
+        // 位逆序输入，自然顺序输出 (DIT)，未乘 1/n
+        void backward(u64 *a, int n, const std::vector<u64> &tw) const
+        {
+            for (int h = 1; h < n; h <<= 1)
+                for (int s = 0; s < n; s += 2 * h)
+                    for (int j = 0; j < h; ++j)
+                    {
+                        u64 u = a[s + j], v = mul(a[s + j + h], tw[h + j]);
+                        a[s + j] = add(u, v);
+                        a[s + j + h] = sub(u, v);
+                    }
+        }
+    };
+
+    const NttPrime ntt_primes[NTT_PRIMES] = {
+        NttPrime(4179340454199820289ull, 3), // 29 * 2^57 + 1
+        NttPrime(2485986994308513793ull, 5), // 69 * 2^55 + 1
+        NttPrime(1945555039024054273ull, 5), // 27 * 2^56 + 1
+    };
+
+    // Garner 算法的常数：p0^{-1} mod p1，(p0 p1)^{-1} mod p2，p0 mod p2，p0 p1
+    struct NttCrt
+    {
+        u64 inv01, inv012, p0m2;
+        u128 p01;
+
+        NttCrt()
+        {
+            const NttPrime &q0 = ntt_primes[0], &q1 = ntt_primes[1], &q2 = ntt_primes[2];
+            inv01 = q1.pow(q0.p % q1.p, q1.p - 2);
+            p0m2 = q0.p % q2.p;
+            p01 = static_cast<u128>(q0.p) * q1.p;
+            inv012 = q2.pow(static_cast<u64>(p01 % q2.p), q2.p - 2);
+        }
+    };
+
+    const NttCrt ntt_crt;
+
+    // f[0, n) = a 模 q 的数值 (补零)，并做正变换
+    void
+    ntt_load(const NttPrime &q, u64 *f, int n, const BIT *a, int na, const std::vector<u64> &tw)
+    {
+        for (int i = 0; i < na; ++i)
+            f[i] = a[i] % q.p;
+        std::fill(f + na, f + n, 0);
+        q.forward(f, n, tw);
+    }
+}
+
+namespace BNLimb
+{
+    void mul_ntt(BIT *r, const BIT *a, int na, const BIT *b, int nb)
+    {
+        bool square = a == b && na == nb;
+        int len = na + nb - 1, n = 1, lg = 0;
+        while (n < len)
+            n <<= 1, ++lg;
+        assert(lg <= NTT_MAX_LOG);
+        (void)lg;
+
+        // c[k][i] 为第 k 个质数下卷积的第 i 项
+        std::vector<u64> c[NTT_PRIMES], f, tw;
+        for (int k = 0; k < NTT_PRIMES; ++k)
+        {
+            const NttPrime &q = ntt_primes[k];
+            c[k].resize(n);
+            q.roots(tw, n, false);
+            ntt_load(q, c[k].data(), n, a, na, tw);
+            if (square)
+            {
+                for (int i = 0; i < n; ++i)
+                    c[k][i] = q.mul(c[k][i], c[k][i]);
+            }
+            else
+            {
+                f.resize(n);
+                ntt_load(q, f.data(), n, b, nb, tw);
+                for (int i = 0; i < n; ++i)
+                    c[k][i] = q.mul(c[k][i], f[i]);
+            }
+
+            // 逐点乘积带有 2^{-64}，与 1/n 一起用 2^128 / n 修正
+            q.roots(tw, n, true);
+            q.backward(c[k].data(), n, tw);
+            u64 scale = q.mul(q.toMont(q.pow(n, q.p - 2)), q.r2);
+            for (int i = 0; i < len; ++i)
+                c[k][i] = q.mul(c[k][i], scale);
+        }
+
+        // 逐项 CRT 还原为三字的数值，累加到 r 的对应位置
+        const NttPrime &q1 = ntt_primes[1], &q2 = ntt_primes[2];
+        std::fill(r, r + na + nb, 0);
+        BIT c0 = 0, c1 = 0, c2 = 0; // 进位窗口，c0 对应当前位
+        for (int i = 0; i < len; ++i)
+        {
+            u64 v0 = c[0][i];
+            u64 v1 = q1.mul(q1.toMont(q1.sub(c[1][i], v0 % q1.p)), ntt_crt.inv01);
+            u64 t = q2.sub(c[2][i], v0 % q2.p);
+            t = q2.sub(t, q2.mul(q2.toMont(v1), ntt_crt.p0m2));
+            u64 v2 = q2.mul(q2.toMont(t), ntt_crt.inv012);
+
+            // x = v0 + v1 p0 + v2 p0 p1
+            u128 lo = static_cast<u128>(v1) * ntt_primes[0].p + v0;
+            u128 m0 = static_cast<u128>(v2) * static_cast<u64>(ntt_crt.p01);
+            u128 m1 = static_cast<u128>(v2) * static_cast<u64>(ntt_crt.p01 >> 64);
+            u128 s0 = static_cast<u128>(static_cast<u64>(lo)) + static_cast<u64>(m0);
+            u128 s1 = (lo >> 64) + (m0 >> 64) + static_cast<u64>(m1) + (s0 >> 64);
+            BIT x0 = static_cast<BIT>(s0), x1 = static_cast<BIT>(s1);
+            BIT x2 = static_cast<BIT>((m1 >> 64) + (s1 >> 64));
+
+            // 当前位加上 x0，下两位分别加上 x1, x2
+            u128 acc = static_cast<u128>(c0) + x0;
+            r[i] = static_cast<BIT>(acc);
+            acc = static_cast<u128>(c1) + x1 + static_cast<BIT>(acc >> 64);
+            c0 = static_cast<BIT>(acc);
+            acc = static_cast<u128>(c2) + x2 + static_cast<BIT>(acc >> 64);
+            c1 = static_cast<BIT>(acc);
+            c2 = static_cast<BIT>(acc >> 64);
+        }
+        if (len < na + nb)
+            r[len] = c0;
+        if (len + 1 < na + nb)
+            r[len + 1] = c1;
+    }
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include <rsa/random.h>
+#include <rsa/limb.h>
 
 #include <random>
 #include <cassert>
@@ -79,10 +80,8 @@ namespace BNRandom
         int try_max_time = 10000000;
         for (int round = 0; round < try_max_time; ++round)
         {
-            if (isPrime(tmp))
+            if (isPrime(tmp) && (!safe || isPrime(tmp >> 1)))
             {
-                if (safe && !isPrime(tmp >> 1))
-                    continue;
 #if not defined(NDEBUG)
                 std::cerr << "tried: " << round + 1 << std::endl;
 #endif
@@ -118,21 +117,90 @@ namespace BNRandom
         return NUMPRIMES;
     }
 
-    // 质数判定，Miller-Rabin
+    // 试除时每批同时计算余数的质数个数，从小批开始以便尽早排除有小因子的候选
+#define TRIAL_MIN_BLOCK 8
+#define TRIAL_MAX_BLOCK 64
+
+    // primes 中各个质数预先求出倒数，试除只需乘法
+    static const std::vector<BNLimb::SmallDivisor> &
+    smallDivisors()
+    {
+        static const std::vector<BNLimb::SmallDivisor> ds(primes, primes + NUMPRIMES);
+        return ds;
+    }
+
+    // 以 2 为底的强伪素数测试，w = 2^a * m + 1，ctx 为 w 的 Montgomery 上下文
+    // 底数为 2 时乘以底数只需左移一位再条件减，Montgomery 形式下同样成立，每位只剩一次模平方
+    static bool
+    sprp2(const BigInt &w, const BigInt &m, int a, const MontgomeryContext &ctx)
+    {
+        BigInt one = ctx.toMont(1);
+        BigInt minus_one = w - one;
+
+        BigInt z = one;
+        for (int i = m.bits() - 1; i >= 0; --i)
+        {
+            z = ctx.sqr(z);
+            if (m.bit(i))
+            {
+                z <<= 1;
+                if (!(z < w))
+                    z -= w;
+            }
+        }
+        if (z == one || z == minus_one)
+            return true;
+
+        for (int j = 1; j < a; ++j)
+        {
+            z = ctx.sqr(z);
+            if (z == minus_one)
+                return true;
+            if (z == one)
+                return false;
+        }
+        return false;
+    }
+
+    bool
+    isStrongProbablePrime2(const BigInt &w)
+    {
+        if (!(w > 3) || !w.bit(0))
+            return w == 2 || w == 3;
+        BigInt w1 = w - 1;
+        int a = w1.ctz();
+        return sprp2(w, w1 >> a, a, MontgomeryContext(w));
+    }
+
+    // 质数判定，试除后先做以 2 为底的强伪素数测试筛掉绝大部分合数，再做随机底数的 Miller-Rabin
     static bool
     isPrime(BigInt w)
     {
+        if (!w.bit(0))
+            return false;
+
         int bits = w.bits();
         int tdiv = getTrialDivision(bits);
-        for (int i = 1; i < tdiv; ++i)
-            if (w % primes[i] == 0)
-                return false;
+        const std::vector<BNLimb::SmallDivisor> &ds = smallDivisors();
+        BIT res[TRIAL_MAX_BLOCK];
+        for (int i = 1, m = TRIAL_MIN_BLOCK; i < tdiv; i += m, m = std::min(2 * m, TRIAL_MAX_BLOCK))
+        {
+            m = std::min(m, tdiv - i);
+            w.residues(ds.data() + i, m, res);
+            for (int j = 0; j < m; ++j)
+                if (res[j] == 0)
+                    return false;
+        }
 
         BigInt w1 = w - 1;
         int a = w1.ctz();
         assert(a >= 1);
         BigInt m = w1 >> a;
 
+        MontgomeryContext ctx(w);
+        if (!sprp2(w, m, a, ctx))
+            return false;
+
         int iter = getMinMRChecks(bits);
         while (iter)
         {
@@ -142,13 +210,13 @@ namespace BNRandom
             if (b < 3)
                 continue;
 
-            BigInt z = b.modPow(m, w);
+            BigInt z = b.modPow(m, ctx);
             if (z == 1 || z == w1)
                 goto loop_cont;
 
             for (int j = 1; j < a; ++j)
             {
-                z = z * z % w;
+                z = z.square() % w;
                 if (z == w1)
                     goto loop_cont;
                 if (z == 1)
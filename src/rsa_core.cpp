@@ -1,8 +1,26 @@
 #include <rsa/rsa_core.h>
+#include <rsa/fixed_big_integer.h>
 #include <iostream>
 #include <fstream>
 #include <cassert>
 
+static inline BigInt
+mod_pow(const BigInt &x, const BigInt &exp, const ModContext &ctx)
+{
+#if defined(BIT_USE_MONTGOMERY)
+    return modPowFixed(x, exp, ctx);
+#else
+    return x.modPow(exp, ctx);
+#endif
+}
+
+void RSAPrivateKey::initContext()
+{
+    nctx = ModContext(n);
+    pctx = ModContext(p);
+    qctx = ModContext(q);
+}
+
 RSAPrivateKey::RSAPrivateKey(int bits)
 {
     if (bits < 34)
@@ -45,7 +63,8 @@ RSAPrivateKey::RSAPrivateKey(int bits)
     dp = d % p1;
     dq = d % q1;
 
-    nm = q * BNAlgo::inv(q, p, true);
+    nm = q * BNAlgo::inv(q, p);
+    initContext();
 }
 
 static std::string line;
@@ -74,6 +93,7 @@ RSAPrivateKey::RSAPrivateKey(const std::string &file)
     dq = read_big_int(f);
     nm = read_big_int(f);
     f.close();
+    initContext();
 }
 
 void RSAPrivateKey::genKey(const std::string &file) const
@@ -116,25 +136,23 @@ BigInt
 RSAPrivateKey::encrypt(const BigInt &x) const
 {
     throw std::runtime_error("should not use...");
-    BigInt xp = (x % p).modPow(ep, p);
-    BigInt xq = (x % q).modPow(eq, q);
-    BigInt res = ((xp - xq) * nm + xq) % n;
-    if (res < 0)
-        return res + n;
-    return res;
+    BigInt xp = mod_pow(x % p, ep, pctx);
+    BigInt xq = mod_pow(x % q, eq, qctx);
+    // (xp - xq) * nm + xq 在同一块存储中求积、相加并取模到 [0, n)
+    xp -= xq;
+    return xp.mulAddMod(nm, xq, n);
 }
 
 BigInt
 RSAPrivateKey::decrypt(const BigInt &x, bool use_crt) const
 {
     if (use_crt == false)
-        return x.modPow(d, n);
-    BigInt xp = (x % p).modPow(dp, p);
-    BigInt xq = (x % q).modPow(dq, q);
-    BigInt res = ((xp - xq) * nm + xq) % n;
-    if (res < 0)
-        return res + n;
-    return res;
+        return mod_pow(x, d, nctx);
+    BigInt xp = mod_pow(x % p, dp, pctx);
+    BigInt xq = mod_pow(x % q, dq, qctx);
+    // (xp - xq) * nm + xq 在同一块存储中求积、相加并取模到 [0, n)
+    xp -= xq;
+    return xp.mulAddMod(nm, xq, n);
 }
 
 BigInt
@@ -152,12 +170,13 @@ RSAPublicKey::RSAPublicKey(const std::string &file)
     n = read_big_int(f);
     e = read_big_int(f);
     f.close();
+    nctx = ModContext(n);
 }
 
 BigInt
 RSAPublicKey::encrypt(const BigInt &x) const
 {
-    return x.modPow(e, n);
+    return mod_pow(x, e, nctx);
 }
 
 bool RSAPublicKey::verify(const BigInt &x, const BigInt &sign) const
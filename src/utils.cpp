@@ -1,8 +1,10 @@
 #include <rsa/utils.h>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 
 void BNUtils::init()
 {
@@ -10,36 +12,32 @@ void BNUtils::init()
     digits.resize(sz);
 }
 
-void BNUtils::clear()
-{
-    while (!digits.empty() && digits.back() == 0)
-        digits.pop_back();
-}
-
+// 分组的字节布局：第 j 字节为数值的第 8j ~ 8j+7 位 (小端)，前 length 字节为数据，随后是长度字段
+// 与宿主机字节序无关，借助大端的 fromBytes/toBytes 再整体翻转
 void BNUtils::encode(const char *src, int len)
 {
     assert(len >= 1);
     assert(len <= length);
-    init();
-    char *dd = (char *)digits.data();
-    memcpy(dd, src, len);
-    memset(dd + len, 0, length - len);
+    std::vector<uint8_t> dd(sz * sizeof(BIT), 0);
+    memcpy(dd.data(), src, len);
     --len;
     for (int j = 0; j <= lenlength; ++j, len >>= 8)
-        *(dd + length + j) = len & 0xFF;
-    clear();
+        dd[length + j] = len & 0xFF;
+    std::reverse(dd.begin(), dd.end());
+    BigInt::operator=(BigInt::fromBytes(dd.data(), dd.size()));
 }
 
 std::string
 BNUtils::decode()
 {
-    init();
-    char *dd = (char *)digits.data();
+    std::vector<uint8_t> dd(sz * sizeof(BIT));
+    toBytes(dd.data(), dd.size());
+    std::reverse(dd.begin(), dd.end());
     int len = 0;
     for (int j = lenlength; j >= 0; --j)
-        len = (len << 8) | (unsigned char)*(dd + length + j);
+        len = (len << 8) | dd[length + j];
     assert(len <= length);
-    return std::string(dd, len + 1);
+    return std::string(reinterpret_cast<const char *>(dd.data()), len + 1);
 }
 
 static inline int
@@ -72,6 +70,9 @@ get_code_len_len(int bits)
     throw std::invalid_argument("Can not get code len len...");
 }
 
+// 单个分组运算过程中临时数值的 arena 初始大小，分组之间整体重置
+#define BLOCK_ARENA_SIZE (1 << 16)
+
 static std::string
 read_all_from_stream(std::istream &input)
 {
@@ -123,17 +124,17 @@ void split_and_encrypt(const std::string &input_path, const std::string &output_
     int sz = (bits + BITL - 1) / BITL;
     BNUtils bt(sz, len, len_len);
 
-    for (int i = 0; i < n; ++i)
-    {
-        bt.encode(content.data() + len * i, len);
-        assert(bt.bits() < pk.bits());
-        out << pk.encrypt(bt).toString() << std::endl;
-    }
-    if (m != 0)
+    std::vector<char> buffer(BLOCK_ARENA_SIZE);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    for (int i = 0; i < n + (m != 0); ++i)
     {
-        bt.encode(content.data() + len * n, m);
-        assert(bt.bits() < pk.bits());
-        out << pk.encrypt(bt).toString() << std::endl;
+        {
+            BigIntResourceScope scope(&arena);
+            bt.encode(content.data() + len * i, i < n ? len : m);
+            assert(bt.bits() < pk.bits());
+            out << pk.encrypt(bt).toString() << std::endl;
+        }
+        arena.release();
     }
 
     CLOSE_INPUT_STREAM();
@@ -152,10 +153,17 @@ void decrypt_and_join(const std::string &input_path, const std::string &output_p
     int sz = (bits + BITL - 1) / BITL;
     BNUtils bt(sz, len, len_len);
 
+    std::vector<char> buffer(BLOCK_ARENA_SIZE);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
     std::string line;
     while (std::getline(in, line))
     {
-        bt = pk.decrypt(BigInt(line));
+        {
+            // bt 不在作用域内创建，赋值时复制而不是接管 arena 中的存储
+            BigIntResourceScope scope(&arena);
+            bt = pk.decrypt(BigInt(line));
+        }
+        arena.release();
         out << bt.decode();
     }
 
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <rsa/big_integer.h>
+#include <rsa/limb.h>
+#include <random>
+#include <vector>
+
+class BigIntegerAVX2Test : public ::testing::Test
+{
+protected:
+    std::mt19937_64 g;
+
+    void SetUp() override
+    {
+        if (!bit_cpu_has_avx2())
+            GTEST_SKIP() << "CPU does not support AVX2";
+        g.seed(114514);
+    }
+
+    std::vector<BIT> randLimbs(int n)
+    {
+        std::vector<BIT> a(n);
+        for (auto &x : a)
+            x = g();
+        a.back() |= 1;
+        return a;
+    }
+};
+
+TEST_F(BigIntegerAVX2Test, MulTest)
+{
+    for (int it = 0; it < 200; ++it)
+    {
+        int nb = BIT_AVX2_THRESHOLD + g() % (BIT_AVX2_MAX_LIMBS - BIT_AVX2_THRESHOLD + 1);
+        int na = nb + g() % nb;
+        std::vector<BIT> a = randLimbs(na), b = randLimbs(nb);
+        if (it % 10 == 0)
+            std::fill(a.begin(), a.end(), ~static_cast<BIT>(0)), std::fill(b.begin(), b.end(), ~static_cast<BIT>(0));
+
+        std::vector<BIT> r1(na + nb), r2(na + nb);
+        unsign_mul_avx2(a.data(), na, b.data(), nb, r1.data());
+        BNLimb::mul_basecase(r2.data(), a.data(), na, b.data(), nb);
+        ASSERT_EQ(r1, r2) << na << " x " << nb;
+    }
+}
+
+TEST_F(BigIntegerAVX2Test, RedcTest)
+{
+    for (int k : {BIT_AVX2_THRESHOLD, 55, 64, 77, BIT_AVX2_MAX_LIMBS})
+    {
+        std::vector<BIT> n = randLimbs(k);
+        n.front() |= 1;
+        BIT ninv = n[0];
+        for (int i = 0; i < 6; ++i)
+            ninv *= 2 - n[0] * ninv;
+        ninv = -ninv;
+        BigInt N(n, false);
+
+        for (int it = 0; it < 20; ++it)
+        {
+            BigInt a = BigInt(randLimbs(k), false) % N, b = BigInt(randLimbs(k), false) % N;
+            if (it == 0)
+                a = N - 1, b = N - 1;
+            BigInt t = a * b;
+
+            std::vector<BIT> tt(2 * k + 1, 0);
+            for (int i = 0; i < 2 * k; ++i)
+                tt[i] = t.word(i);
+            redc_avx2(tt.data(), tt.data(), 2 * k, n.data(), k, ninv);
+            tt.resize(k + 1);
+            tt.resize(BNLimb::normalize(tt.data(), k + 1));
+            BigInt r(tt, false);
+
+            // r * B^k = t (mod N) 且 r < 2N
+            ASSERT_TRUE(r < N + N);
+            ASSERT_EQ((r << (k * BITL)) % N, t % N);
+        }
+    }
+}
+
+TEST_F(BigIntegerAVX2Test, MontgomeryContextTest)
+{
+    for (int k : {BIT_AVX2_THRESHOLD, 64, BIT_AVX2_MAX_LIMBS})
+    {
+        std::vector<BIT> n = randLimbs(k);
+        n.front() |= 1;
+        BigInt N(n, false);
+        MontgomeryContext ctx(N);
+        for (int it = 0; it < 10; ++it)
+        {
+            BigInt a(randLimbs(k + 1), false), b(randLimbs(k), false);
+            ASSERT_EQ(ctx.fromMont(ctx.mul(ctx.toMont(a), ctx.toMont(b))), a * b % N);
+        }
+
+        BigInt x(randLimbs(k), false), e(randLimbs(2), false);
+        ASSERT_EQ(x.modPow(e, ctx), x.modPowBasic(e, N));
+    }
+}
+
+TEST_F(BigIntegerAVX2Test, ShortInputTest)
+{
+    for (int k = BIT_AVX2_THRESHOLD; k <= BIT_AVX2_MAX_LIMBS; k += 8)
+    {
+        std::vector<BIT> n = randLimbs(k);
+        n.front() |= 1;
+        BigInt N(n, false);
+        MontgomeryContext ctx(N);
+
+        // fromMont(x) = x * B^{-k} mod N，即满足 r * B^k = x (mod N) 的 r
+        for (int c : {0, 1, 5, 12345})
+        {
+            BigInt r = ctx.fromMont(BigInt(c));
+            ASSERT_TRUE(r < N) << k;
+            ASSERT_EQ((r << (k * BITL)) % N, BigInt(c)) << k << " " << c;
+        }
+        for (int len : {1, 2, k / 2, k - 1, k})
+        {
+            BigInt x(randLimbs(len), false);
+            x = x % N;
+            ASSERT_EQ(ctx.fromMont(ctx.toMont(x)), x) << k << " " << len;
+        }
+
+        BigInt x(randLimbs(3), false), e(randLimbs(1), false);
+        ASSERT_EQ(x.modPowMontgomery(e, ctx), x.modPowBasic(e, N)) << k;
+    }
+}
@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 #include <rsa/big_integer.h>
 #include <rsa/random.h>
+#include <rsa/fixed_big_integer.h>
+#include <rsa/limb.h>
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 class BigIntegerTest : public ::testing::Test
 {
@@ -31,6 +35,65 @@ TEST_F(BigIntegerTest, ToFromString)
     ASSERT_EQ(to, x);
 }
 
+TEST_F(BigIntegerTest, DecimalTest)
+{
+    // python 默认只允许 4300 位以内的十进制整数转换
+    ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py dec -n 30 -m 3000 -s 0"), 0);
+    std::ifstream f("/tmp/big_integer_test_dec");
+    ASSERT_TRUE(f.is_open());
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        BigInt x = BigInt(line);
+        ASSERT_EQ(x.toString(), line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt y = BigInt(line);
+        ASSERT_EQ(x, y);
+        ASSERT_EQ(x.toString(10), line);
+    }
+    f.close();
+
+    ASSERT_EQ(BigInt("0").toString(10), "0");
+    ASSERT_EQ(BigInt("-0"), 0);
+    ASSERT_EQ(BigInt("18446744073709551616").toString(), "0x10000000000000000");
+    ASSERT_EQ(BigInt("0x1_0000_0000").toString(10), "4294967296");
+
+    // 10 的幂附近的值，分治输出时商的估计最容易偏小
+    for (int len : {1216, 2432, 4864, 9728})
+    {
+        std::string nines(len, '9'), pow10 = "1" + std::string(len, '0');
+        ASSERT_EQ(BigInt(nines).toString(10), nines);
+        ASSERT_EQ(BigInt(pow10).toString(10), pow10);
+        ASSERT_EQ((BigInt(pow10) + BigInt(pow10)).toString(10), "2" + std::string(len, '0'));
+    }
+}
+
+TEST_F(BigIntegerTest, BytesTest)
+{
+    const uint8_t be[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B};
+    BigInt x = BigInt::fromBytes(be, sizeof(be));
+    ASSERT_EQ(x.toString(), "0x102030405060708090A0B");
+
+    uint8_t out[16];
+    x.toBytes(out, sizeof(out));
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(out[i], 0);
+    ASSERT_TRUE(std::equal(be, be + sizeof(be), out + 5));
+    ASSERT_THROW(x.toBytes(out, 10), std::runtime_error);
+    ASSERT_EQ(BigInt::fromBytes(out, 0), 0);
+
+    BNRandom::initRandom(4);
+    for (int bits : {1, 63, 64, 65, 1000, 2048})
+    {
+        BigInt y = BNRandom::getRandInt(bits);
+        std::vector<uint8_t> buf((bits + 7) / 8 + 3);
+        y.toBytes(buf.data(), buf.size());
+        ASSERT_EQ(BigInt::fromBytes(buf.data(), buf.size()), y);
+    }
+}
+
 TEST_F(BigIntegerTest, AddTest)
 {
     ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py add -n 20 -m 1000000 -s 0"), 0);
@@ -52,6 +115,9 @@ TEST_F(BigIntegerTest, AddTest)
         ASSERT_EQ(z.toString(), line);
 
         ASSERT_EQ(x + y, z);
+        ASSERT_EQ(BigInt(x) + y, z);
+        ASSERT_EQ(BigInt(x) += y, z);
+        ASSERT_EQ(BigInt(z) -= y, x);
     }
     f.close();
 }
@@ -77,6 +143,9 @@ TEST_F(BigIntegerTest, SubTest)
         ASSERT_EQ(z.toString(), line);
 
         ASSERT_EQ(x - y, z);
+        ASSERT_EQ(BigInt(x) - y, z);
+        ASSERT_EQ(BigInt(x) -= y, z);
+        ASSERT_EQ(BigInt(z) += y, x);
     }
     f.close();
 }
@@ -102,6 +171,29 @@ TEST_F(BigIntegerTest, MulTest)
         ASSERT_EQ(z.toString(), line);
 
         ASSERT_EQ(x * y, z);
+        ASSERT_EQ(BigInt(x) *= y, z);
+    }
+    f.close();
+}
+
+TEST_F(BigIntegerTest, SqrTest)
+{
+    ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py sqr -n 30 -m 100000 -s 0"), 0);
+    std::ifstream f("/tmp/big_integer_test_sqr");
+    ASSERT_TRUE(f.is_open());
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        BigInt x = BigInt(line);
+        ASSERT_EQ(x.toString(), line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt z = BigInt(line);
+        ASSERT_EQ(z.toString(), line);
+
+        ASSERT_EQ(x.square(), z);
+        ASSERT_EQ(x * x, z);
     }
     f.close();
 }
@@ -144,6 +236,8 @@ TEST_F(BigIntegerTest, DivTest)
 
         ASSERT_EQ(x / y, z);
         ASSERT_EQ(x % y, zm);
+        ASSERT_EQ(BigInt(x) % y, zm);
+        ASSERT_EQ(BigInt(x) %= y, zm);
     }
     f.close();
 }
@@ -173,6 +267,32 @@ TEST_F(BigIntegerTest, RshiftTest)
     f.close();
 }
 
+TEST_F(BigIntegerTest, LshiftTest)
+{
+    ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py lshift -n 1000 -m 10000 -s 0"), 0);
+    std::ifstream f("/tmp/big_integer_test_lshift");
+    ASSERT_TRUE(f.is_open());
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        BigInt x = BigInt(line);
+        ASSERT_EQ(x.toString(), line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        int b = std::stoi(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt y = BigInt(line);
+        ASSERT_EQ(y.toString(), line);
+
+        ASSERT_EQ(x << b, y);
+        ASSERT_EQ(y >> b, x);
+        ASSERT_EQ(x <<= b, y);
+    }
+    f.close();
+}
+
 TEST_F(BigIntegerTest, CompareTest)
 {
     int max_test = 1000;
@@ -270,4 +390,446 @@ TEST_F(BigIntegerTest, BigCmpTest)
         ASSERT_EQ(x < x, false);
     }
     f.close();
-}
\ No newline at end of file
+}
+
+TEST_F(BigIntegerTest, MontgomeryTest)
+{
+    ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py modpow -n 10 -m 1000 -s 0"), 0);
+    std::ifstream f("/tmp/big_integer_test_modpow");
+    ASSERT_TRUE(f.is_open());
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        BigInt x = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt y = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt z = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt m = BigInt(line);
+
+        if ((z % 2) == 0)
+            continue;
+
+        MontgomeryContext ctx(z);
+        ASSERT_EQ(ctx.fromMont(ctx.toMont(x)), x % z);
+        ASSERT_EQ((x % z).modPowMontgomery(y, ctx), m);
+        ASSERT_EQ((x % z).modPowCios(y, ctx), m);
+    }
+    f.close();
+}
+
+TEST_F(BigIntegerTest, CiosTest)
+{
+    BNRandom::initRandom(8);
+    for (int k = 1; k <= 70; k += (k < 10 ? 1 : 7))
+    {
+        BigInt n = BNRandom::getRandInt(k * BITL) | 1;
+        if (k % 3 == 0)
+            n = (BigInt(1) << (k * BITL)) - BigInt(1);
+        MontgomeryContext ctx(n);
+        for (int it = 0; it < 20; ++it)
+        {
+            BigInt a = BNRandom::getRandInt(k * BITL, false) % n;
+            BigInt b = BNRandom::getRandInt(BNRandom::getRandWord() % (k * BITL) + 1, false) % n;
+            if (it == 0)
+                a = n - 1, b = n - 1;
+            if (it == 1)
+                b = 0;
+            ASSERT_EQ(ctx.mulCios(a, b), ctx.mul(a, b)) << k;
+            ASSERT_EQ(ctx.sqrCios(a), ctx.sqr(a)) << k;
+            ASSERT_EQ(ctx.sqrCios(b), ctx.sqr(b)) << k;
+        }
+    }
+}
+
+TEST_F(BigIntegerTest, ModPowBackendTest)
+{
+    ASSERT_EQ(system("python3 ../../scripts/big_integer_test_gen.py modpow -n 10 -m 500 -s 0"), 0);
+    std::ifstream f("/tmp/big_integer_test_modpow");
+    ASSERT_TRUE(f.is_open());
+
+    std::string line;
+    while (std::getline(f, line))
+    {
+        BigInt x = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt y = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt z = BigInt(line);
+
+        ASSERT_TRUE(std::getline(f, line));
+        BigInt m = BigInt(line);
+
+        ASSERT_EQ((x % z).modPowBasic(y, z), m);
+        ASSERT_EQ((x % z).modPowBarrett(y, z), m);
+
+        BarrettContext ctx(z);
+        ASSERT_EQ(x.modPow(y, ctx), m);
+        ASSERT_EQ(ctx.reduce((x % z).square()), (x % z).square() % z);
+        ASSERT_EQ((x % z).modMul(m, ctx), (x % z) * m % z);
+    }
+    f.close();
+}
+
+TEST_F(BigIntegerTest, FixedModPowTest)
+{
+    BNRandom::initRandom(1);
+    for (int bits : {1024, 2048, 3072, 4096})
+    {
+        BigInt n = BNRandom::getRandInt(bits);
+        n |= 1;
+        BigInt e = BNRandom::getRandInt(bits, false);
+        BigInt x = BNRandom::getRandInt(bits + 17, false);
+
+        MontgomeryContext ctx(n);
+        FixedBigInt<4096 / BITL> a(x % n);
+        ASSERT_EQ(a.toBigInt(), x % n);
+
+        ASSERT_EQ(modPowFixed(x, e, n), (x % n).modPowBasic(e, n));
+        ASSERT_EQ(modPowFixed(x, e, ctx), (x % n).modPowBasic(e, n));
+        ASSERT_EQ(modPowFixed(x, BigInt(), n), 1);
+    }
+}
+
+TEST_F(BigIntegerTest, FixedLiteralTest)
+{
+    constexpr auto e = 65537_big;
+    static_assert(decltype(e)::size() == 1 && e.digits[0] == 65537, "decimal literal");
+    static_assert(0x1'0001_big == e && 0b1'0000'0000'0000'0001_big == e && 0200001_big == e, "prefixed literals");
+    static_assert(decltype(0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_big)::size() == 128 / BITL, "limbs from hex digits");
+
+    constexpr auto d = 714617997665971646619174575775866316813159434152037120684615_big;
+    ASSERT_EQ(d.toBigInt(), BigInt("714617997665971646619174575775866316813159434152037120684615"));
+
+    constexpr auto n = 0x87362BEA1D978D8CA29AF482FCE799CDB895579CDDA3426B77BF23B970FE21E40341123CC414D39DEC13F9ABB97582C6488B09ACB4E16C74CE6F291A26BB9D18FFADA062C1FB0CF7B4B4E566177F53C2AE80B07AABBF3B842B5C138B31B03DD52AD61D54FF8F735C37E06C7B2EBE57949530FCD9D6FD1D9B62032801B65C1C29_big;
+    static_assert(decltype(n)::size() == 1024 / BITL, "1024-bit modulus");
+    BigInt m("0x87362BEA1D978D8CA29AF482FCE799CDB895579CDDA3426B77BF23B970FE21E40341123CC414D39DEC13F9ABB97582C6488B09ACB4E16C74CE6F291A26BB9D18FFADA062C1FB0CF7B4B4E566177F53C2AE80B07AABBF3B842B5C138B31B03DD52AD61D54FF8F735C37E06C7B2EBE57949530FCD9D6FD1D9B62032801B65C1C29");
+    ASSERT_EQ(n.toBigInt(), m);
+    ASSERT_EQ(FixedBigInt<2048 / BITL>(n).toBigInt(), m);
+
+    FixedMontgomery<1024 / BITL> ctx(n);
+    BigInt x = d.toBigInt() * 7 % m;
+    ASSERT_EQ(ctx.modPow(x, e.toBigInt()), x.modPowBasic(65537, m));
+}
+
+TEST_F(BigIntegerTest, LimbTest)
+{
+    BNRandom::initRandom(2);
+    for (int it = 0; it < 200; ++it)
+    {
+        int na = BNRandom::getRandWord() % 80 + 1;
+        int nb = BNRandom::getRandWord() % na + 1;
+        std::vector<BIT> a(na), b(nb);
+        for (auto &x : a)
+            x = BNRandom::getRandWord();
+        for (auto &x : b)
+            x = BNRandom::getRandWord();
+        b.back() |= 1;
+        BigInt x(a, false), y(b, false);
+
+        std::vector<BIT> p(na + nb);
+        BNLimb::mul(p.data(), a.data(), na, b.data(), nb);
+        p.resize(BNLimb::normalize(p.data(), p.size()));
+        ASSERT_EQ(BigInt(p, false), x * y);
+
+        std::vector<BIT> q(na - nb + 1), r(nb);
+        BNLimb::divrem(q.data(), r.data(), a.data(), na, b.data(), nb);
+        q.resize(BNLimb::normalize(q.data(), q.size()));
+        r.resize(BNLimb::normalize(r.data(), r.size()));
+        ASSERT_EQ(BigInt(q, false), x / y);
+        ASSERT_EQ(BigInt(r, false), x % y);
+
+        std::vector<BIT> m(a);
+        m.push_back(~static_cast<BIT>(0));
+        BNLimb::mod(m.data(), na, b.data(), nb);
+        m.resize(BNLimb::normalize(m.data(), nb));
+        ASSERT_EQ(BigInt(m, false), x % y);
+
+        BigInt z = BigInt(0) - x;
+        z %= y;
+        ASSERT_EQ(z, (BigInt(0) - x) % y);
+        z = x;
+        z *= y;
+        ASSERT_EQ(z, x * y);
+        z *= z;
+        ASSERT_EQ(z, (x * y).square());
+
+        std::vector<BIT> s(na);
+        BIT c = BNLimb::add(s.data(), a.data(), na, b.data(), nb);
+        s.push_back(c);
+        s.resize(BNLimb::normalize(s.data(), s.size()));
+        ASSERT_EQ(BigInt(s, false), x + y);
+
+        BIT w = b.front();
+        std::vector<BIT> t(na + 1);
+        t[na] = BNLimb::mul_1(t.data(), a.data(), na, w);
+        ASSERT_EQ(BNLimb::submul_1(t.data(), a.data(), na, w), t[na]);
+        ASSERT_EQ(BNLimb::normalize(t.data(), na), 0);
+    }
+}
+
+TEST_F(BigIntegerTest, MulAddModTest)
+{
+    BNRandom::initRandom(7);
+    for (int it = 0; it < 300; ++it)
+    {
+        int bits = BNRandom::getRandWord() % (BITL * 150) + 1;
+        BigInt a = BNRandom::getRandInt(BNRandom::getRandWord() % bits + 1, false);
+        BigInt b = BNRandom::getRandInt(BNRandom::getRandWord() % bits + 1, false);
+        BigInt c = BNRandom::getRandInt(BNRandom::getRandWord() % (2 * bits) + 1, false);
+        BigInt m = BNRandom::getRandInt(bits);
+        if (it & 1)
+            a = BigInt(0) - a;
+        if (it & 2)
+            c = BigInt(0) - c;
+        if (it % 7 == 0)
+            b = 0;
+        if (it % 11 == 0)
+            c = 0;
+
+        BigInt expect = (a * b + c) % m;
+        if (expect < 0)
+            expect += m;
+        ASSERT_EQ(a.mulAddMod(b, c, m), expect);
+        ASSERT_EQ(a.mulAddMod(a, c, m), (expect = (a.square() + c) % m) < 0 ? expect + m : expect);
+
+        // 低位乘积与完整乘积的低 n 个字一致
+        std::vector<BIT> x(a.bits() / BITL + 1), y(b.bits() / BITL + 1);
+        for (size_t i = 0; i < x.size(); ++i)
+            x[i] = a.word(i);
+        for (size_t i = 0; i < y.size(); ++i)
+            y[i] = b.word(i);
+        int n = BNRandom::getRandWord() % (x.size() + y.size()) + 1;
+        std::vector<BIT> lo(n);
+        BNLimb::mul_lo(lo.data(), x.data(), x.size(), y.data(), y.size(), n);
+        lo.resize(BNLimb::normalize(lo.data(), n));
+        x.resize(BNLimb::normalize(x.data(), x.size()));
+        y.resize(BNLimb::normalize(y.data(), y.size()));
+        BigInt full = BigInt(x, false) * BigInt(y, false);
+        ASSERT_EQ(BigInt(lo, false), full - ((full >> (n * BITL)) << (n * BITL)));
+
+        BarrettContext ctx(m);
+        BigInt t = BNRandom::getRandInt(BNRandom::getRandWord() % (2 * ctx.size() * BITL) + 1, false);
+        ASSERT_EQ(ctx.reduce(t), t % m);
+    }
+}
+
+TEST_F(BigIntegerTest, SmallDivisorTest)
+{
+    BNRandom::initRandom(6);
+    std::vector<BIT> divisors = {1, 2, 3, 7, 65521, static_cast<BIT>(10000000000000000000ull), ~static_cast<BIT>(0), static_cast<BIT>(1) << (BITL - 1)};
+    for (int i = 0; i < 20; ++i)
+        divisors.push_back(BNRandom::getRandWord() >> (i * 3 % BITL) | 1);
+    std::vector<BNLimb::SmallDivisor> ds(divisors.begin(), divisors.end());
+
+    for (int n : {0, 1, 2, 5, 40})
+    {
+        std::vector<BIT> a(n);
+        for (auto &x : a)
+            x = BNRandom::getRandWord();
+        if (n >= 2)
+            a[n - 2] = ~static_cast<BIT>(0);
+        BigInt x(a, false);
+
+        std::vector<BIT> res(ds.size());
+        x.residues(ds.data(), ds.size(), res.data());
+        for (size_t j = 0; j < ds.size(); ++j)
+        {
+            BIT b = divisors[j];
+            BITT pre = 0;
+            std::vector<BIT> q0(n), q1(n), q2(n);
+            for (int i = n - 1; i >= 0; --i)
+            {
+                pre = (pre << BITL) | a[i];
+                q0[i] = static_cast<BIT>(pre / b);
+                pre %= b;
+            }
+            BIT r = static_cast<BIT>(pre);
+
+            ASSERT_EQ(BNLimb::divrem_1(q1.data(), a.data(), n, ds[j]), r) << b;
+            ASSERT_EQ(q1, q0) << b;
+            if (n > 0)
+            {
+                ASSERT_EQ(BNLimb::divrem_1(q2.data(), a.data(), n, b), r) << b;
+                ASSERT_EQ(q2, q0) << b;
+            }
+            ASSERT_EQ(BNLimb::mod_1(a.data(), n, ds[j]), r) << b;
+            ASSERT_EQ(res[j], r) << b;
+            if (b < 65536)
+            {
+                ASSERT_EQ(x % static_cast<prime_t>(b), r) << b;
+            }
+        }
+    }
+}
+
+TEST_F(BigIntegerTest, NttTest)
+{
+    BNRandom::initRandom(3);
+    auto rand_limbs = [](int n, bool ones)
+    {
+        std::vector<BIT> a(n);
+        for (auto &x : a)
+            x = ones ? ~static_cast<BIT>(0) : BNRandom::getRandWord();
+        a.back() |= 1;
+        return a;
+    };
+
+    std::pair<int, int> sizes[] = {{1, 1}, {2, 1}, {3, 3}, {17, 5}, {100, 100}, {1000, 999}, {3000, 70}, {2048, 2048}};
+    for (auto [na, nb] : sizes)
+    {
+        for (bool ones : {false, true})
+        {
+            std::vector<BIT> a = rand_limbs(na, ones), b = rand_limbs(nb, ones);
+            std::vector<BIT> r1(na + nb), r2(na + nb);
+            BNLimb::mul_ntt(r1.data(), a.data(), na, b.data(), nb);
+            BNLimb::mul_basecase(r2.data(), a.data(), na, b.data(), nb);
+            ASSERT_EQ(r1, r2) << na << " x " << nb;
+
+            std::vector<BIT> s1(2 * na), s2(2 * na);
+            BNLimb::mul_ntt(s1.data(), a.data(), na, a.data(), na);
+            BNLimb::sqr_basecase(s2.data(), a.data(), na);
+            ASSERT_EQ(s1, s2) << na << "^2";
+        }
+    }
+
+    // 超过 BIT_NTT_THRESHOLD 时 operator* 与 square 自动使用数论变换
+    int na = BIT_NTT_THRESHOLD + 1000, nb = BIT_NTT_THRESHOLD;
+    std::vector<BIT> a = rand_limbs(na, false), b = rand_limbs(nb, false);
+    std::vector<BIT> r(na + nb);
+    BNLimb::mul_basecase(r.data(), a.data(), na, b.data(), nb);
+    BigInt x(a, false), y(b, false);
+    ASSERT_EQ(x * y, BigInt(r, false));
+    r.resize(2 * nb);
+    BNLimb::sqr_basecase(r.data(), b.data(), nb);
+    ASSERT_EQ(y.square(), BigInt(r, false));
+}
+
+// 记录其他线程调用次数的内存资源
+class ThreadRecordingResource : public std::pmr::memory_resource
+{
+public:
+    std::thread::id owner = std::this_thread::get_id();
+    std::atomic<int> calls{0}, foreign{0};
+
+private:
+    void record()
+    {
+        ++calls;
+        if (std::this_thread::get_id() != owner)
+            ++foreign;
+    }
+    void *do_allocate(size_t bytes, size_t align) override
+    {
+        record();
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t align) override
+    {
+        record();
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_F(BigIntegerTest, ParallelMulTest)
+{
+    // 单核机器上也强制拆到多个线程，检查并行路径的结果
+    // 线程预算为 2 时每次拆分只能放出一个子任务，其余在调用者线程上执行
+    BNRandom::initRandom(5);
+    std::pair<int, int> sizes[] = {{BIT_PARALLEL_THRESHOLD, BIT_PARALLEL_THRESHOLD}, {1500, 900}, {3000, 2500}, {4000, 4000}};
+    for (int threads : {2, 4})
+        for (auto [na, nb] : sizes)
+        {
+            BNLimb::set_threads(threads);
+            std::vector<BIT> a(na), b(nb);
+            for (auto &x : a)
+                x = BNRandom::getRandWord();
+            for (auto &x : b)
+                x = BNRandom::getRandWord();
+
+            std::vector<BIT> r1(na + nb), r2(na + nb);
+            BNLimb::mul(r1.data(), a.data(), na, b.data(), nb);
+            BNLimb::mul_basecase(r2.data(), a.data(), na, b.data(), nb);
+            ASSERT_EQ(r1, r2) << na << " x " << nb;
+
+            std::vector<BIT> s1(2 * na), s2(2 * na);
+            BNLimb::sqr(s1.data(), a.data(), na);
+            BNLimb::sqr_basecase(s2.data(), a.data(), na);
+            ASSERT_EQ(s1, s2) << na << "^2";
+        }
+
+    // 子任务线程不能在调用者的 arena 上申请或释放存储
+    ThreadRecordingResource res;
+    BigInt x = BNRandom::getRandInt(3000 * BITL), y = BNRandom::getRandInt(2500 * BITL);
+    BigInt expect = x * y;
+    {
+        BigIntResourceScope scope(&res);
+        BigInt z = x * y;
+        ASSERT_EQ(z, expect);
+        z = x.square();
+        ASSERT_EQ(z, expect = x * x);
+    }
+    ASSERT_GT(res.calls, 0);
+    ASSERT_EQ(res.foreign, 0);
+    BNLimb::set_threads(0);
+}
+
+// 统计申请次数的内存资源
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int count = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t align) override
+    {
+        ++count;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t align) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_F(BigIntegerTest, MemoryResourceTest)
+{
+    BNRandom::initRandom(3);
+    BigInt a = BNRandom::getRandInt(20000), b = BNRandom::getRandInt(15000);
+    BigInt expect = a * b + a;
+
+    CountingResource counter;
+    std::pmr::monotonic_buffer_resource arena(&counter);
+    BigInt res;
+    {
+        BigIntResourceScope scope(&arena);
+        BigInt tmp = a * b;
+        tmp += a;
+        res = std::move(tmp);
+    }
+    arena.release();
+    ASSERT_GT(counter.count, 0);
+    ASSERT_EQ(res, expect);
+
+    int before = counter.count;
+    BigInt c(&counter);
+    c = a;
+    ASSERT_EQ(counter.count, before + 1);
+    ASSERT_EQ(c, a);
+    ASSERT_EQ(BigInt(std::move(c)), a);
+}
@@ -50,4 +50,51 @@ TEST_F(RandomTest, RandomPrimeTest)
         p.debug();
         ASSERT_TRUE(p.bits() >= i);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(RandomTest, RandomPrimeFermatTest)
+{
+    for (int bits : {17, 64, 200, 512})
+    {
+        BigInt p = BNRandom::getRandPrime(bits);
+        ASSERT_EQ(p.bits(), bits);
+        for (int b : {2, 3, 5, 7, 11})
+            ASSERT_EQ(BigInt(b).modPow(p - 1, p), 1);
+    }
+
+    for (int bits : {17, 64})
+    {
+        BigInt s = BNRandom::getRandPrime(bits, true);
+        BigInt q = s >> 1;
+        for (int b : {2, 3, 5})
+        {
+            ASSERT_EQ(BigInt(b).modPow(s - 1, s), 1);
+            ASSERT_EQ(BigInt(b).modPow(q - 1, q), 1);
+        }
+    }
+}
+
+TEST_F(RandomTest, StrongProbablePrime2Test)
+{
+    // 质数
+    for (const char *p : {"0x2", "0x3", "0x5", "0x10001", "0x7FFFFFFF", "0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"})
+        ASSERT_TRUE(BNRandom::isStrongProbablePrime2(BigInt(p)));
+    BigInt p521 = BigInt(1) << 521;
+    BigInt m521 = p521 - 1;
+    ASSERT_TRUE(BNRandom::isStrongProbablePrime2(m521));
+    for (int bits : {64, 512})
+        ASSERT_TRUE(BNRandom::isStrongProbablePrime2(BNRandom::getRandPrime(bits)));
+
+    // Carmichael 数与以 2 为底的 Fermat 伪素数
+    for (int c : {341, 561, 645, 1105, 1387, 1729, 2465, 2821, 6601, 8911, 41041, 825265})
+        ASSERT_FALSE(BNRandom::isStrongProbablePrime2(BigInt(c)));
+    // 偶数与一般合数
+    ASSERT_FALSE(BNRandom::isStrongProbablePrime2(BigInt(1)));
+    ASSERT_FALSE(BNRandom::isStrongProbablePrime2(BigInt(65536)));
+    BigInt n = BNRandom::getRandPrime(256) * BNRandom::getRandPrime(256);
+    ASSERT_FALSE(BNRandom::isStrongProbablePrime2(n));
+
+    // 以 2 为底的强伪素数能通过该测试，需要后续随机底数的 Miller-Rabin 排除
+    for (int c : {2047, 3277, 4033, 4681, 8321})
+        ASSERT_TRUE(BNRandom::isStrongProbablePrime2(BigInt(c)));
+}
@@ -32,4 +32,72 @@ TEST_F(RSACoreTest, RSACoreTest)
 
     BigInt s = pk1.decrypt(x);
     ASSERT_TRUE(pk2.verify(x, s));
-}
\ No newline at end of file
+}
+
+TEST_F(RSACoreTest, InvTest)
+{
+    for (int bits : {64, 200, 1024, 4096})
+    {
+        BigInt p = BNRandom::getRandPrime(bits / 2);
+        for (int i = 0; i < 10; ++i)
+        {
+            BigInt n = BNRandom::getRandInt(bits);
+            BigInt a = BNRandom::getRandInt(bits - 7, false);
+            auto [ret, x, y] = BNAlgo::inv_exgcd(n, a);
+            BigInt g = n * x + a * y;
+            ASSERT_EQ(ret, g == 1);
+            ASSERT_EQ(n % g, 0);
+            ASSERT_EQ(a % g, 0);
+
+            BigInt inv = BNAlgo::inv(a, n);
+            if (ret)
+            {
+                ASSERT_EQ(a * inv % n, 1);
+            }
+            else
+            {
+                ASSERT_EQ(inv, -1);
+            }
+
+            BigInt b = a % p;
+            if (b != 0)
+            {
+                ASSERT_EQ(BNAlgo::inv(b, p), BNAlgo::inv(b, p, true));
+            }
+        }
+    }
+}
+
+TEST_F(RSACoreTest, MultiModPowTest)
+{
+    for (int bits : {64, 521, 2048})
+    {
+        BigInt odd = BNRandom::getRandInt(bits) | 1;
+        BigInt even = BNRandom::getRandInt(bits) >> 1 << 1;
+        for (const BigInt &mod : {odd, even})
+        {
+            for (int n = 1; n <= 4; ++n)
+            {
+                BNAlgo::PowTerms terms;
+                BigInt expect = BigInt(1) % mod;
+                for (int k = 0; k < n; ++k)
+                {
+                    BigInt b = BNRandom::getRandInt(bits + 10 * k);
+                    if (k == 1)
+                        b = BigInt(0) - b;
+                    BigInt e = k == 2 ? BigInt(0) : BNRandom::getRandInt(bits / (k + 1));
+                    expect = expect * b.modPow(e, mod) % mod;
+                    if (expect < 0)
+                        expect += mod;
+                    terms.emplace_back(b, e);
+                }
+                ASSERT_EQ(BNAlgo::multiModPow(terms, mod), expect);
+            }
+        }
+    }
+
+    BigInt n = BNRandom::getRandInt(256) | 1;
+    ASSERT_EQ(BNAlgo::multiModPow({}, n), 1);
+    ASSERT_EQ(BNAlgo::multiModPow({{BigInt(3), BigInt(0)}}, n), 1);
+    ASSERT_THROW(BNAlgo::multiModPow({{BigInt(3), BigInt(-1)}}, n), std::invalid_argument);
+}